@@ -0,0 +1,362 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "common.hpp"
+#include "cppxAsyncFile.hpp"
+#include "cppxBuffer.hpp"
+#include "cppxChecksum.hpp"
+
+using cppx::Buffer;
+using cppx::FileReader;
+using cppx::IoEngine;
+using cppx::PrefetchReader;
+
+namespace {
+constexpr const std::size_t piece_size = 64 * 1024 - 1;
+
+std::string benchPath(std::int64_t megabytes)
+{
+	return (std::filesystem::temp_directory_path() / ("cppx_asyncfile_bench_" + std::to_string(megabytes))).string();
+}
+
+//! @brief Writes the input file once; later runs read it from the page cache like any warm local file
+std::string input(std::int64_t megabytes)
+{
+	static struct Written {
+		std::vector<std::pair<std::int64_t, std::string>> files;
+
+		~Written()
+		{
+			for (const auto &file : files)
+				std::remove(file.second.c_str());
+		}
+	} written;
+
+	for (const auto &file : written.files)
+		if (file.first == megabytes)
+			return file.second;
+
+	const auto path = benchPath(megabytes);
+	const auto contents = bench::noise(static_cast<std::size_t>(megabytes) << 20);
+
+	IoEngine().write(path, contents).get();
+	written.files.emplace_back(megabytes, path);
+
+	return written.files.back().second;
+}
+
+IoEngine &engine(std::int64_t backend)
+{
+	static IoEngine threads([]() {
+		cppx::IoOptions options;
+		options.backend = cppx::IoBackend::threads;
+		return options;
+	}());
+
+	static IoEngine automatic;
+
+	return backend ? automatic : threads;
+}
+
+//! @brief Skips the run when the kernel has no io_uring for the uring variant
+bool usable(benchmark::State &state, std::int64_t backend)
+{
+	if (backend && engine(backend).backend() != cppx::IoBackend::uring) {
+		state.SkipWithError("io_uring is not available");
+		return false;
+	}
+
+	return true;
+}
+
+void reportLatency(benchmark::State &state, std::vector<double> &latencies)
+{
+	if (latencies.empty())
+		return;
+
+	std::sort(latencies.begin(), latencies.end());
+
+	state.counters["p50_us"] = latencies[latencies.size() / 2];
+	state.counters["p99_us"] = latencies[latencies.size() * 99 / 100];
+	state.counters["max_us"] = latencies.back();
+}
+
+double microseconds(std::chrono::steady_clock::time_point since)
+{
+	return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - since).count();
+}
+
+constexpr const std::int64_t scan_megabytes = 2048;
+
+//! @brief A 2 GB file, removed at exit
+class ScanFile {
+private:
+	std::string m_path;
+
+public:
+	ScanFile()
+	    : m_path(benchPath(scan_megabytes))
+	{
+		cppx::FileWriter writer(engine(0), m_path);
+		const auto piece = bench::noise(std::size_t(64) << 20);
+
+		for (std::int64_t i = 0; i < scan_megabytes / 64; ++i)
+			writer.write(piece).get();
+	}
+
+	~ScanFile()
+	{
+		std::remove(m_path.c_str());
+	}
+
+	const std::string &path() const noexcept
+	{
+		return m_path;
+	}
+
+	//! @brief Drops the file from the page cache, so the next scan reads the disk
+	void evict() const
+	{
+		const auto fd = ::open(m_path.c_str(), O_RDONLY);
+		::fdatasync(fd);
+		::posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+		::close(fd);
+	}
+};
+
+const ScanFile &scanFile()
+{
+	static const ScanFile result;
+	return result;
+}
+} // namespace
+
+// whole files: open, size, read into one buffer
+static void BM_BlockingRead(benchmark::State &state)
+{
+	const auto &path = input(state.range(0));
+
+	for (auto _ : state) {
+		const auto fd = ::open(path.c_str(), O_RDONLY);
+		struct stat info;
+		::fstat(fd, &info);
+
+		auto buffer = Buffer::Heap(static_cast<std::size_t>(info.st_size));
+		auto data = static_cast<std::uint8_t *>(buffer.data());
+
+		for (std::size_t done = 0; done < buffer.size();) {
+			const auto result = ::read(fd, data + done, buffer.size() - done);
+			if (result <= 0)
+				break;
+
+			done += static_cast<std::size_t>(result);
+		}
+
+		::close(fd);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * (state.range(0) << 20));
+}
+BENCHMARK(BM_BlockingRead)->Arg(1)->Arg(64)->UseRealTime();
+
+// backend 0 is the thread pool, 1 is io_uring
+static void BM_IoEngineRead(benchmark::State &state)
+{
+	if (!usable(state, state.range(0)))
+		return;
+
+	const auto &path = input(state.range(1));
+	auto &io = engine(state.range(0));
+
+	for (auto _ : state) {
+		auto buffer = io.read(path).get();
+		benchmark::DoNotOptimize(buffer.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * (state.range(1) << 20));
+}
+BENCHMARK(BM_IoEngineRead)->ArgsProduct({{0, 1}, {1, 64}})->UseRealTime();
+
+static void BM_BlockingWrite(benchmark::State &state)
+{
+	const auto path = benchPath(state.range(0)) + ".out";
+	const auto contents = bench::noise(static_cast<std::size_t>(state.range(0)) << 20);
+	auto data = static_cast<const std::uint8_t *>(contents.data());
+
+	for (auto _ : state) {
+		const auto fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+
+		for (std::size_t done = 0; done < contents.size();) {
+			const auto result = ::write(fd, data + done, contents.size() - done);
+			if (result <= 0)
+				break;
+
+			done += static_cast<std::size_t>(result);
+		}
+
+		::close(fd);
+	}
+
+	std::remove(path.c_str());
+	state.SetBytesProcessed(state.iterations() * (state.range(0) << 20));
+}
+BENCHMARK(BM_BlockingWrite)->Arg(1)->Arg(64)->UseRealTime();
+
+static void BM_IoEngineWrite(benchmark::State &state)
+{
+	if (!usable(state, state.range(0)))
+		return;
+
+	const auto path = benchPath(state.range(1)) + ".out";
+	const auto contents = bench::noise(static_cast<std::size_t>(state.range(1)) << 20);
+	auto &io = engine(state.range(0));
+
+	for (auto _ : state)
+		io.write(path, contents).get();
+
+	std::remove(path.c_str());
+	state.SetBytesProcessed(state.iterations() * (state.range(1) << 20));
+}
+BENCHMARK(BM_IoEngineWrite)->ArgsProduct({{0, 1}, {1, 64}})->UseRealTime();
+
+// streaming a 64 MB file in 64 KB pieces, each consumed and erased so the next lands in the same tail;
+// the counters are the latency of single pieces
+static void BM_BlockingReadPieces(benchmark::State &state)
+{
+	const auto &path = input(64);
+	std::vector<double> latencies;
+
+	for (auto _ : state) {
+		const auto fd = ::open(path.c_str(), O_RDONLY);
+		Buffer target;
+
+		for (;;) {
+			const auto start = std::chrono::steady_clock::now();
+
+			if (target.preallocated() < piece_size)
+				target.selfPreallocate(piece_size - target.preallocated(), Buffer::onHeap);
+
+			const auto result = ::read(fd, static_cast<std::uint8_t *>(target.data()) + target.size(), piece_size);
+			if (result <= 0)
+				break;
+
+			target.selfCommit(static_cast<std::size_t>(result));
+			latencies.push_back(microseconds(start));
+
+			benchmark::DoNotOptimize(target.data());
+			target.selfErase(0, target.size());
+		}
+
+		::close(fd);
+	}
+
+	reportLatency(state, latencies);
+	state.SetBytesProcessed(state.iterations() * (std::int64_t(64) << 20));
+}
+BENCHMARK(BM_BlockingReadPieces)->UseRealTime();
+
+static void BM_FileReaderPieces(benchmark::State &state)
+{
+	if (!usable(state, state.range(0)))
+		return;
+
+	const auto &path = input(64);
+	auto &io = engine(state.range(0));
+	std::vector<double> latencies;
+
+	for (auto _ : state) {
+		FileReader reader(io, path);
+		Buffer target;
+
+		for (;;) {
+			const auto start = std::chrono::steady_clock::now();
+
+			if (!reader.readInto(target, piece_size).get())
+				break;
+
+			latencies.push_back(microseconds(start));
+
+			benchmark::DoNotOptimize(target.data());
+			target.selfErase(0, target.size());
+		}
+	}
+
+	reportLatency(state, latencies);
+	state.SetBytesProcessed(state.iterations() * (std::int64_t(64) << 20));
+}
+BENCHMARK(BM_FileReaderPieces)->Arg(0)->Arg(1)->UseRealTime();
+
+// scanning a 2 GB file from disk in 1 MB chunks, with a checksum as the processing;
+// the blocking scan reads a chunk, then processes it, so the two never overlap
+static void BM_ScanBlocking(benchmark::State &state)
+{
+	const auto &file = scanFile();
+	auto chunk = Buffer::Heap(std::size_t(1) << 20);
+	std::uint32_t crc = 0;
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		file.evict();
+		state.ResumeTiming();
+
+		const auto fd = ::open(file.path().c_str(), O_RDONLY);
+
+		for (;;) {
+			const auto result = ::read(fd, chunk.data(), chunk.size());
+			if (result <= 0)
+				break;
+
+			crc = cppx::crc32c(chunk.data(), static_cast<std::size_t>(result), crc);
+		}
+
+		::close(fd);
+	}
+
+	benchmark::DoNotOptimize(crc);
+	state.SetBytesProcessed(state.iterations() * (scan_megabytes << 20));
+}
+BENCHMARK(BM_ScanBlocking)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// depth chunks are read ahead while one is processed; backend 0 is the thread pool, 1 is io_uring
+static void BM_ScanPrefetch(benchmark::State &state)
+{
+	if (!usable(state, state.range(0)))
+		return;
+
+	const auto &file = scanFile();
+	auto &io = engine(state.range(0));
+	std::uint32_t crc = 0;
+	std::size_t allocations = 0;
+
+	cppx::PrefetchOptions options;
+	options.depth = static_cast<std::size_t>(state.range(1));
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		file.evict();
+		state.ResumeTiming();
+
+		PrefetchReader reader(io, file.path(), options);
+
+		while (const auto chunk = reader.next())
+			crc = cppx::crc32c(chunk, crc);
+
+		allocations = reader.allocations();
+	}
+
+	benchmark::DoNotOptimize(crc);
+	state.counters["allocations"] = static_cast<double>(allocations);
+	state.SetBytesProcessed(state.iterations() * (scan_megabytes << 20));
+}
+BENCHMARK(BM_ScanPrefetch)->ArgsProduct({{0, 1}, {1, 2, 4}})->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,118 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+
+#include "common.hpp"
+#include "cppxBits.hpp"
+#include "cppxBuffer.hpp"
+
+using cppx::Bits;
+using cppx::Buffer;
+
+namespace {
+constexpr const std::size_t bitmap_size = std::size_t(64) << 20;
+} // namespace
+
+static void BM_BitsXor(benchmark::State &state)
+{
+	auto target = bench::noise(bitmap_size);
+	const auto mask = bench::noise(bitmap_size);
+
+	for (auto _ : state) {
+		Bits::selfXor(target, mask);
+		benchmark::DoNotOptimize(target.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * bitmap_size);
+}
+BENCHMARK(BM_BitsXor)->Unit(benchmark::kMillisecond);
+
+static void BM_BitsXorByteLoop(benchmark::State &state)
+{
+	auto target = bench::noise(bitmap_size);
+	const auto mask = bench::noise(bitmap_size);
+
+	for (auto _ : state) {
+		for (std::size_t i = 0; i < bitmap_size; ++i)
+			target[i] ^= mask[i];
+
+		benchmark::DoNotOptimize(target.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * bitmap_size);
+}
+BENCHMARK(BM_BitsXorByteLoop)->Unit(benchmark::kMillisecond);
+
+static void BM_BitsPopcount(benchmark::State &state)
+{
+	const auto bitmap = bench::noise(bitmap_size);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(Bits::popcount(bitmap));
+
+	state.SetBytesProcessed(state.iterations() * bitmap_size);
+}
+BENCHMARK(BM_BitsPopcount)->Unit(benchmark::kMillisecond);
+
+static void BM_BitsPopcountByteLoop(benchmark::State &state)
+{
+	const auto bitmap = bench::noise(bitmap_size);
+
+	for (auto _ : state) {
+		std::size_t count = 0;
+
+		for (std::size_t i = 0; i < bitmap_size; ++i)
+			for (auto byte = bitmap[i]; byte; byte &= static_cast<std::uint8_t>(byte - 1))
+				++count;
+
+		benchmark::DoNotOptimize(count);
+	}
+
+	state.SetBytesProcessed(state.iterations() * bitmap_size);
+}
+BENCHMARK(BM_BitsPopcountByteLoop)->Unit(benchmark::kMillisecond);
+
+static void BM_BitsFindFirstSet(benchmark::State &state)
+{
+	auto bitmap = Buffer::Heap(bitmap_size);
+	std::memset(bitmap.data(), 0, bitmap_size);
+	Bits::set(bitmap, bitmap_size * 8 - 1);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(Bits::findFirstSet(bitmap));
+
+	state.SetBytesProcessed(state.iterations() * bitmap_size);
+}
+BENCHMARK(BM_BitsFindFirstSet)->Unit(benchmark::kMillisecond);
+
+static void BM_BitsShift(benchmark::State &state)
+{
+	auto bitmap = bench::noise(bitmap_size);
+
+	for (auto _ : state) {
+		Bits::selfShiftLeft(bitmap, 13);
+		benchmark::DoNotOptimize(bitmap.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * bitmap_size);
+}
+BENCHMARK(BM_BitsShift)->Unit(benchmark::kMillisecond);
+
+static void BM_BitsShiftByteLoop(benchmark::State &state)
+{
+	auto bitmap = bench::noise(bitmap_size);
+
+	for (auto _ : state) {
+		// the 13-bit shift as a one-byte move and a 5-bit carry loop
+		for (std::size_t i = bitmap_size - 1; i > 1; --i)
+			bitmap[i] = static_cast<std::uint8_t>((bitmap[i - 1] << 5) | (bitmap[i - 2] >> 3));
+
+		bitmap[1] = static_cast<std::uint8_t>(bitmap[0] << 5);
+		bitmap[0] = 0;
+
+		benchmark::DoNotOptimize(bitmap.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * bitmap_size);
+}
+BENCHMARK(BM_BitsShiftByteLoop)->Unit(benchmark::kMillisecond);
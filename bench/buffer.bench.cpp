@@ -0,0 +1,579 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "common.hpp"
+#include "cppxBuffer.hpp"
+
+using cppx::Buffer;
+
+#pragma region Constructors
+
+static void BM_BufferConstruct(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+	const auto manager = bench::manager(state.range(1));
+
+	for (auto _ : state) {
+		auto buffer = Buffer(manager, size);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+
+	state.SetLabel(manager->name);
+}
+BENCHMARK(BM_BufferConstruct)->Apply(bench::sizesAndManagers);
+
+static void BM_BufferHeapFrom(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+	const auto source = std::vector<std::uint8_t>(size, 0x5A);
+
+	for (auto _ : state) {
+		auto buffer = Buffer::HeapFrom((void *)source.data(), size);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BufferHeapFrom)->Apply(bench::sizes);
+
+static void BM_BufferHeapPreall(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+
+	for (auto _ : state) {
+		auto buffer = Buffer::HeapPreall(size);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+}
+BENCHMARK(BM_BufferHeapPreall)->Arg(bench::small_size)->Arg(bench::medium_size)->Arg(cppx::BufferCore::max_preall);
+
+static void BM_BufferHeapZeroed(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+
+	for (auto _ : state) {
+		auto buffer = Buffer::HeapZeroed(size);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+}
+BENCHMARK(BM_BufferHeapZeroed)->Arg(bench::medium_size)->Arg(bench::large_size)->Arg(64 << 20);
+
+// the zeroing done by hand, which faults in every page
+static void BM_BufferHeapMemset(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+
+	for (auto _ : state) {
+		auto buffer = Buffer::Heap(size);
+		std::memset(buffer.data(), 0, size);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+}
+BENCHMARK(BM_BufferHeapMemset)->Arg(bench::medium_size)->Arg(bench::large_size)->Arg(64 << 20);
+
+static std::vector<Buffer::Span> batchSpans(const std::vector<std::uint8_t> &source, std::size_t count)
+{
+	std::vector<Buffer::Span> spans;
+	spans.reserve(count);
+
+	// sizes between 16 and 256 bytes
+	for (std::size_t i = 0, offset = 0; i < count; ++i) {
+		const auto size = 16 + (i * 37) % 241;
+
+		spans.emplace_back(source.data() + offset, size);
+		offset = (offset + size) % (source.size() - 256);
+	}
+
+	return spans;
+}
+
+static void BM_BufferHeapBatch(benchmark::State &state)
+{
+	const auto source = std::vector<std::uint8_t>(bench::large_size, 0x5A);
+	const auto spans = batchSpans(source, static_cast<std::size_t>(state.range(0)));
+
+	for (auto _ : state) {
+		auto buffers = Buffer::HeapBatch(spans);
+		benchmark::DoNotOptimize(buffers.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BufferHeapBatch)->Arg(16)->Arg(1024)->Arg(16384);
+
+static void BM_BufferHeapFromEach(benchmark::State &state)
+{
+	const auto source = std::vector<std::uint8_t>(bench::large_size, 0x5A);
+	const auto spans = batchSpans(source, static_cast<std::size_t>(state.range(0)));
+
+	for (auto _ : state) {
+		std::vector<Buffer> buffers;
+		buffers.reserve(spans.size());
+
+		for (const auto &span : spans)
+			buffers.push_back(Buffer::HeapFrom((void *)span.first, span.second));
+
+		benchmark::DoNotOptimize(buffers.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BufferHeapFromEach)->Arg(16)->Arg(1024)->Arg(16384);
+
+static void BM_BufferStack(benchmark::State &state)
+{
+	std::uint8_t data[bench::small_size] = {};
+
+	for (auto _ : state) {
+		auto buffer = Buffer::Stack(data, sizeof(data));
+		benchmark::DoNotOptimize(buffer.data());
+	}
+}
+BENCHMARK(BM_BufferStack);
+
+static void BM_BufferCopy(benchmark::State &state)
+{
+	const auto source = bench::noise(static_cast<std::size_t>(state.range(0)), bench::manager(state.range(1)));
+
+	for (auto _ : state) {
+		auto copy = source;
+		benchmark::DoNotOptimize(copy.data());
+	}
+
+	state.SetLabel(source.manager()->name);
+}
+BENCHMARK(BM_BufferCopy)->Apply(bench::sizesAndManagers);
+
+// Constructors
+#pragma endregion
+#pragma region Operations
+
+static void BM_BufferClone(benchmark::State &state)
+{
+	const auto source = bench::noise(static_cast<std::size_t>(state.range(0)), bench::manager(state.range(1)));
+
+	for (auto _ : state) {
+		auto clone = source.clone();
+		benchmark::DoNotOptimize(clone.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+	state.SetLabel(source.manager()->name);
+}
+BENCHMARK(BM_BufferClone)->Apply(bench::sizesAndManagers);
+
+static void BM_BufferRange(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+	const auto source = bench::noise(size, bench::manager(state.range(1)));
+
+	for (auto _ : state) {
+		auto range = source.range(size / 4, size - size / 4);
+		benchmark::DoNotOptimize(range.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * (state.range(0) / 2));
+	state.SetLabel(source.manager()->name);
+}
+BENCHMARK(BM_BufferRange)->Apply(bench::sizesAndManagers);
+
+static void BM_BufferRangeView(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+	const auto data = bench::noise(size);
+	const auto source = Buffer::Static(data.data(), size);
+
+	for (auto _ : state) {
+		auto range = source.range(size / 4, size - size / 4);
+		benchmark::DoNotOptimize(range.data());
+	}
+}
+BENCHMARK(BM_BufferRangeView)->Apply(bench::sizes);
+
+static void BM_BufferInsert(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+	const auto source = bench::noise(size, bench::manager(state.range(1)));
+	const auto value = bench::noise(bench::small_size);
+
+	for (auto _ : state) {
+		auto result = source.insert(size / 2, value);
+		benchmark::DoNotOptimize(result.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * (state.range(0) + bench::small_size));
+	state.SetLabel(source.manager()->name);
+}
+BENCHMARK(BM_BufferInsert)->Apply(bench::sizesAndManagers);
+
+static void BM_BufferSelfInsert(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+	const auto source = bench::noise(size, bench::manager(state.range(1)));
+	const auto value = bench::noise(bench::small_size);
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		auto target = source.clone();
+		state.ResumeTiming();
+
+		target.selfInsert(size / 2, value);
+		benchmark::DoNotOptimize(target.data());
+	}
+
+	state.SetLabel(source.manager()->name);
+}
+BENCHMARK(BM_BufferSelfInsert)->Apply(bench::sizesAndManagers);
+
+static void BM_BufferSelfInsertPreallocated(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+	const auto value = bench::noise(bench::small_size);
+
+	auto target = bench::noise(size);
+	target.selfPreallocate(bench::small_size);
+
+	// erasing the inserted bytes hands them back to the preallocated tail
+	for (auto _ : state) {
+		target.selfInsert(size / 2, value);
+		target.selfErase(size / 2, size / 2 + bench::small_size);
+		benchmark::DoNotOptimize(target.data());
+	}
+}
+BENCHMARK(BM_BufferSelfInsertPreallocated)->Apply(bench::sizes);
+
+static void BM_BufferErase(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+	const auto source = bench::noise(size, bench::manager(state.range(1)));
+
+	for (auto _ : state) {
+		auto result = source.erase(size / 4, size / 2);
+		benchmark::DoNotOptimize(result.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * (state.range(0) - state.range(0) / 4));
+	state.SetLabel(source.manager()->name);
+}
+BENCHMARK(BM_BufferErase)->Apply(bench::sizesAndManagers);
+
+static void BM_BufferSelfErase(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+	const auto source = bench::noise(size, bench::manager(state.range(1)));
+
+	for (auto _ : state) {
+		state.PauseTiming();
+		auto target = source.clone();
+		state.ResumeTiming();
+
+		target.selfErase(size / 4, size / 4 + bench::small_size / 2);
+		benchmark::DoNotOptimize(target.data());
+	}
+
+	state.SetLabel(source.manager()->name);
+}
+BENCHMARK(BM_BufferSelfErase)->Apply(bench::sizesAndManagers);
+
+static void BM_BufferReverse(benchmark::State &state)
+{
+	const auto source = bench::noise(static_cast<std::size_t>(state.range(0)), bench::manager(state.range(1)));
+
+	for (auto _ : state) {
+		auto result = source.reverse();
+		benchmark::DoNotOptimize(result.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+	state.SetLabel(source.manager()->name);
+}
+BENCHMARK(BM_BufferReverse)->Apply(bench::sizesAndManagers);
+
+static void BM_BufferSelfReverse(benchmark::State &state)
+{
+	auto target = bench::noise(static_cast<std::size_t>(state.range(0)), bench::manager(state.range(1)));
+
+	for (auto _ : state) {
+		target.selfReverse();
+		benchmark::DoNotOptimize(target.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+	state.SetLabel(target.manager()->name);
+}
+BENCHMARK(BM_BufferSelfReverse)->Apply(bench::sizesAndManagers);
+
+static void BM_BufferSelfFill(benchmark::State &state)
+{
+	auto target = Buffer::Heap(static_cast<std::size_t>(state.range(0)));
+
+	for (auto _ : state) {
+		target.selfFill(0x5A);
+		benchmark::DoNotOptimize(target.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BufferSelfFill)->Apply(bench::sizes);
+
+// the per-byte loop selfFill replaces
+static void BM_BufferFillAt(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+	auto target = Buffer::Heap(size);
+
+	for (auto _ : state) {
+		for (std::size_t i = 0; i < size; ++i)
+			target.at(i) = 0x5A;
+
+		benchmark::DoNotOptimize(target.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BufferFillAt)->Apply(bench::sizes);
+
+static void BM_BufferSelfFillPattern(benchmark::State &state)
+{
+	auto target = Buffer::Heap(static_cast<std::size_t>(state.range(0)));
+	const auto pattern = bench::noise(13);
+
+	for (auto _ : state) {
+		target.selfFill(pattern);
+		benchmark::DoNotOptimize(target.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BufferSelfFillPattern)->Apply(bench::sizes);
+
+static void BM_BufferCompare(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+	const auto left = bench::noise(size, bench::manager(state.range(1)));
+	const auto right = left.clone();
+
+	// equal contents: the whole buffer is scanned
+	for (auto _ : state)
+		benchmark::DoNotOptimize(left.compare(right));
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+	state.SetLabel(left.manager()->name);
+}
+BENCHMARK(BM_BufferCompare)->Apply(bench::sizesAndManagers);
+
+static void BM_BufferRepresent(benchmark::State &state)
+{
+	const auto source = bench::noise(static_cast<std::size_t>(state.range(0)));
+	const auto form = static_cast<std::uint8_t>(state.range(1));
+
+	for (auto _ : state) {
+		auto result = source.represent(form);
+		benchmark::DoNotOptimize(result.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+	state.SetLabel(form == Buffer::HEX ? "hex" : "binary");
+}
+BENCHMARK(BM_BufferRepresent)->ArgsProduct({{bench::small_size, bench::medium_size, bench::large_size}, {Buffer::HEX, Buffer::BINARY}});
+
+// Operations
+#pragma endregion
+#pragma region Traversal
+
+static void BM_BufferIterate(benchmark::State &state)
+{
+	const auto source = bench::noise(static_cast<std::size_t>(state.range(0)));
+
+	for (auto _ : state) {
+		std::size_t sum = 0;
+
+		for (const auto byte : source)
+			sum += byte;
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BufferIterate)->Apply(bench::sizes);
+
+static void BM_BufferIterateAt(benchmark::State &state)
+{
+	const auto source = bench::noise(static_cast<std::size_t>(state.range(0)));
+
+	for (auto _ : state) {
+		std::size_t sum = 0;
+
+		for (std::size_t i = 0; i < source.size(); ++i)
+			sum += source.at(i);
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BufferIterateAt)->Apply(bench::sizes);
+
+static void BM_BufferIterateData(benchmark::State &state)
+{
+	const auto source = bench::noise(static_cast<std::size_t>(state.range(0)));
+
+	for (auto _ : state) {
+		const auto data = reinterpret_cast<const std::uint8_t *>(source.data());
+		std::size_t sum = 0;
+
+		for (std::size_t i = 0; i < source.size(); ++i)
+			sum += data[i];
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BufferIterateData)->Apply(bench::sizes);
+
+// Traversal
+#pragma endregion
+#pragma region CopyOnWrite
+
+/**
+ * @brief Copies a buffer and writes into one in |range(1)| of the copies
+ * @details On heapManager every copy shares the data anyway; heapCowManager
+ *          pays for a detach only on the copies that are written to, and a
+ *          clone-per-copy baseline pays on every copy.
+ */
+static void BM_BufferCopyThenMutate(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+	const auto every = static_cast<std::size_t>(state.range(1));
+	const auto source = bench::noise(size, Buffer::onHeapCow);
+
+	std::size_t counter = 0;
+
+	for (auto _ : state) {
+		auto copy = source;
+
+		if (++counter % every == 0)
+			copy[0] = static_cast<std::uint8_t>(counter);
+
+		benchmark::DoNotOptimize(copy.data());
+	}
+}
+BENCHMARK(BM_BufferCopyThenMutate)->ArgsProduct({{bench::medium_size, bench::large_size}, {1, 16, 256}});
+
+static void BM_BufferCloneThenMutate(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+	const auto every = static_cast<std::size_t>(state.range(1));
+	const auto source = bench::noise(size);
+
+	std::size_t counter = 0;
+
+	for (auto _ : state) {
+		auto copy = source.clone();
+
+		if (++counter % every == 0)
+			copy[0] = static_cast<std::uint8_t>(counter);
+
+		benchmark::DoNotOptimize(copy.data());
+	}
+}
+BENCHMARK(BM_BufferCloneThenMutate)->ArgsProduct({{bench::medium_size, bench::large_size}, {1, 16, 256}});
+
+// CopyOnWrite
+#pragma endregion
+#pragma region Growth
+
+/**
+ * @brief Grows a buffer from 1 KB to 1 GB by doubling
+ * @details heapManager grows with realloc, which glibc serves with mremap for
+ *          blocks this large; the second manager has no reallocate and copies.
+ */
+static void BM_BufferGrowth(benchmark::State &state)
+{
+	constexpr const std::size_t initial = std::size_t(1) << 10;
+	constexpr const std::size_t final = std::size_t(1) << 30;
+
+	static const cppx::BufferManager copyingManager = {
+	    "copyingManager",
+	    {1, 1, 0},
+	    Buffer::heapManager.alloc,
+	    Buffer::heapManager.release};
+
+	const auto manager = state.range(0) ? Buffer::onHeap : &copyingManager;
+
+	// untouched calloc pages read as zero without being backed
+	const auto zeros = std::unique_ptr<void, decltype(&std::free)>(std::calloc(final / 2, 1), &std::free);
+
+	for (auto _ : state) {
+		auto buffer = Buffer(manager, initial);
+
+		while (buffer.size() < final)
+			buffer.selfAppend(Buffer::Static(zeros.get(), buffer.size()));
+
+		benchmark::DoNotOptimize(buffer.data());
+	}
+
+	state.SetLabel(manager->name);
+}
+BENCHMARK(BM_BufferGrowth)->Arg(1)->Arg(0)->Unit(benchmark::kMillisecond)->Iterations(3);
+
+// Growth
+#pragma endregion
+#pragma region Footprint
+
+/**
+ * @brief Long-lived buffers growing and shrinking between 256 B and 32 KB
+ * @details Reports the bytes held by the buffers against their payload, without
+ *          trimming (range(0) == 0) and with the given trim ratio in percent.
+ */
+static void BM_BufferFluctuatingFootprint(benchmark::State &state)
+{
+	constexpr const std::size_t count = 256;
+
+	const auto previous = Buffer::trimPolicy();
+	Buffer::setTrimPolicy({static_cast<float>(state.range(0)) / 100.0f, 1024});
+
+	const auto chunk = bench::noise(256);
+	std::vector<Buffer> buffers(count, Buffer());
+
+	for (auto &buffer : buffers)
+		buffer = chunk.clone();
+
+	std::size_t round = 0, held = 0, payload = 0;
+
+	for (auto _ : state) {
+		auto &buffer = buffers[round % count];
+
+		// every buffer swings between growing and shrinking phases
+		if ((round / count) % 64 < 32)
+			buffer.selfAppend(chunk);
+		else if (buffer.size() > chunk.size())
+			buffer.selfErase(0, buffer.size() / 2);
+
+		++round;
+
+		if (round % count == 0) {
+			for (const auto &each : buffers) {
+				held += each.totalsize();
+				payload += each.size();
+			}
+		}
+	}
+
+	const auto samples = static_cast<double>(round / count ? round / count : 1);
+
+	state.counters["held"] = benchmark::Counter(static_cast<double>(held) / samples, benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+	state.counters["payload"] = benchmark::Counter(static_cast<double>(payload) / samples, benchmark::Counter::kDefaults, benchmark::Counter::kIs1024);
+
+	Buffer::setTrimPolicy(previous);
+}
+BENCHMARK(BM_BufferFluctuatingFootprint)->Arg(0)->Arg(100)->Arg(400);
+
+// Footprint
+#pragma endregion
@@ -0,0 +1,104 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "common.hpp"
+#include "cppxBuffer.hpp"
+#include "cppxCache.hpp"
+
+using cppx::Buffer;
+using cppx::BufferCache;
+
+namespace {
+constexpr const std::size_t key_count = 100000;
+constexpr const std::size_t value_size = 1024;
+
+//! @brief Samples key indices with probability proportional to 1 / (rank + 1)^s
+class Zipf {
+private:
+	std::vector<double> m_cdf;
+
+public:
+	explicit Zipf(std::size_t count, double s = 0.99)
+	    : m_cdf(count)
+	{
+		double sum = 0;
+
+		for (std::size_t i = 0; i < count; ++i)
+			m_cdf[i] = sum += 1.0 / std::pow(static_cast<double>(i + 1), s);
+
+		for (auto &value : m_cdf)
+			value /= sum;
+	}
+
+	template <typename Generator>
+	std::size_t operator()(Generator &generator) const
+	{
+		const auto u = std::uniform_real_distribution<double>(0.0, 1.0)(generator);
+		return static_cast<std::size_t>(std::lower_bound(m_cdf.begin(), m_cdf.end(), u) - m_cdf.begin());
+	}
+};
+
+const std::vector<Buffer> &keys()
+{
+	static const std::vector<Buffer> result = []() {
+		std::vector<Buffer> keys;
+		keys.reserve(key_count);
+
+		for (std::size_t i = 0; i < key_count; ++i) {
+			const auto key = "/render/" + std::to_string(i * 2654435761u);
+			keys.push_back(Buffer::HeapFrom((void *)key.data(), key.size()));
+		}
+
+		return keys;
+	}();
+
+	return result;
+}
+
+const Zipf &zipf()
+{
+	static const Zipf result(key_count);
+	return result;
+}
+} // namespace
+
+// every miss "renders" a value and puts it; the budget holds a fraction of the keys
+static void BM_BufferCacheZipf(benchmark::State &state)
+{
+	static BufferCache *cache = nullptr;
+
+	if (state.thread_index() == 0)
+		cache = new BufferCache(static_cast<std::size_t>(state.range(0)) << 20);
+
+	const auto &all = keys();
+	const auto rendered = bench::noise(value_size);
+	std::mt19937_64 generator(state.thread_index() + 1);
+	Buffer value;
+
+	for (auto _ : state) {
+		const auto &key = all[zipf()(generator)];
+
+		if (!cache->get(key, value))
+			cache->put(key, rendered.clone());
+
+		benchmark::DoNotOptimize(value.data());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+
+	if (state.thread_index() == 0) {
+		state.counters["hitRatio"] = cache->stats().hitRatio();
+		delete cache;
+	}
+}
+#ifdef CPPX_BUFFER_ATOMIC
+BENCHMARK(BM_BufferCacheZipf)->Arg(4)->Arg(32)->Threads(1)->Threads(4)->Threads(8)->UseRealTime();
+#else
+// cached values are shared, so more threads need atomic reference counts
+BENCHMARK(BM_BufferCacheZipf)->Arg(4)->Arg(32)->UseRealTime();
+#endif
@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+
+#include <array>
+
+#include "common.hpp"
+#include "cppxChecksum.hpp"
+
+namespace {
+//! @brief Scalar table-driven CRC-32C, one byte per step
+std::uint32_t scalarCrc32c(const std::uint8_t *data, std::size_t size)
+{
+	static const auto s_table = []() {
+		std::array<std::uint32_t, 256> table = {};
+
+		for (std::uint32_t i = 0; i < 256; ++i) {
+			std::uint32_t c = i;
+
+			for (int bit = 0; bit < 8; ++bit)
+				c = (c & 1) ? (c >> 1) ^ 0x82F63B78u : c >> 1;
+
+			table[i] = c;
+		}
+
+		return table;
+	}();
+
+	std::uint32_t crc = ~0u;
+
+	for (std::size_t i = 0; i < size; ++i)
+		crc = (crc >> 8) ^ s_table[(crc ^ data[i]) & 0xFF];
+
+	return ~crc;
+}
+} // namespace
+
+static void BM_Crc32c(benchmark::State &state)
+{
+	const auto source = bench::noise(static_cast<std::size_t>(state.range(0)));
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(cppx::crc32c(source));
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+	state.SetLabel(cppx::crc32cAccelerated() ? "sse4.2" : "table");
+}
+BENCHMARK(BM_Crc32c)->Apply(bench::sizes)->Arg(16 << 20);
+
+static void BM_Crc32cScalarTable(benchmark::State &state)
+{
+	const auto source = bench::noise(static_cast<std::size_t>(state.range(0)));
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(scalarCrc32c(reinterpret_cast<const std::uint8_t *>(source.data()), source.size()));
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Crc32cScalarTable)->Apply(bench::sizes)->Arg(16 << 20);
+
+static void BM_Crc32cCombine(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(cppx::crc32cCombine(0x12345678u, 0x9ABCDEF0u, size));
+}
+BENCHMARK(BM_Crc32cCombine)->Arg(bench::small_size)->Arg(bench::large_size);
+
+static void BM_Adler32(benchmark::State &state)
+{
+	const auto source = bench::noise(static_cast<std::size_t>(state.range(0)));
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(cppx::adler32(source));
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_Adler32)->Apply(bench::sizes)->Arg(16 << 20);
@@ -0,0 +1,116 @@
+#include <benchmark/benchmark.h>
+
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include "common.hpp"
+#include "cppxBuffer.hpp"
+#include "cppxColumnStore.hpp"
+
+using cppx::Buffer;
+using cppx::ColumnStore;
+
+namespace {
+#pragma pack(push, 1)
+struct Record {
+	std::uint64_t timestamp;
+	std::uint32_t id;
+	float price;
+	std::uint8_t payload[16];
+};
+#pragma pack(pop)
+
+std::vector<Record> records(std::size_t count)
+{
+	std::vector<Record> result(count);
+
+	for (std::size_t i = 0; i < count; ++i)
+		result[i] = Record{i * 1000, static_cast<std::uint32_t>(i), static_cast<float>(i % 100), {}};
+
+	return result;
+}
+
+ColumnStore columnStore(const std::vector<Record> &rows)
+{
+	ColumnStore result({sizeof(std::uint64_t), sizeof(std::uint32_t), sizeof(float), 16});
+	result.selfAppendRows(rows.data(), rows.size());
+
+	return result;
+}
+
+std::vector<Buffer> bufferPerRecord(const std::vector<Record> &rows)
+{
+	std::vector<Buffer> result;
+	result.reserve(rows.size());
+
+	for (const auto &row : rows)
+		result.push_back(Buffer::HeapFrom((void *)&row, sizeof(row)));
+
+	return result;
+}
+} // namespace
+
+static void BM_ColumnStoreScan(benchmark::State &state)
+{
+	const auto store = columnStore(records(static_cast<std::size_t>(state.range(0))));
+
+	for (auto _ : state) {
+		float sum = 0;
+
+		for (const auto price : store.view<float>(2))
+			sum += price;
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ColumnStoreScan)->Arg(1 << 10)->Arg(1 << 20);
+
+// the same field read from one buffer per record
+static void BM_BufferPerRecordScan(benchmark::State &state)
+{
+	const auto buffers = bufferPerRecord(records(static_cast<std::size_t>(state.range(0))));
+
+	for (auto _ : state) {
+		float sum = 0;
+
+		for (const auto &buffer : buffers) {
+			float price;
+			std::memcpy(&price, static_cast<const std::uint8_t *>(buffer.data()) + offsetof(Record, price), sizeof(price));
+			sum += price;
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BufferPerRecordScan)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_ColumnStoreAppend(benchmark::State &state)
+{
+	const auto rows = records(static_cast<std::size_t>(state.range(0)));
+
+	for (auto _ : state) {
+		auto store = columnStore(rows);
+		benchmark::DoNotOptimize(store.rows());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ColumnStoreAppend)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_BufferPerRecordAppend(benchmark::State &state)
+{
+	const auto rows = records(static_cast<std::size_t>(state.range(0)));
+
+	for (auto _ : state) {
+		auto buffers = bufferPerRecord(rows);
+		benchmark::DoNotOptimize(buffers.data());
+	}
+
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_BufferPerRecordAppend)->Arg(1 << 10)->Arg(1 << 20);
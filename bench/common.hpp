@@ -0,0 +1,74 @@
+#ifndef CPPX_BENCH_COMMON_H
+#define CPPX_BENCH_COMMON_H
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+#include "cppxBuffer.hpp"
+
+namespace bench {
+
+constexpr const std::int64_t small_size = 64;
+constexpr const std::int64_t medium_size = 4 << 10;
+constexpr const std::int64_t large_size = 1 << 20;
+
+//! @brief Managers that the benchmarks are run on, indexed by a benchmark argument
+inline const cppx::BufferManager *manager(std::int64_t index)
+{
+	static const cppx::BufferManager *const s_managers[] = {cppx::Buffer::onHeap, cppx::Buffer::onHeapCow};
+	return s_managers[index];
+}
+
+constexpr const std::int64_t manager_count = 2;
+
+//! @brief Deterministic pseudo-random contents
+inline cppx::Buffer noise(std::size_t size, const cppx::BufferManager *manager = cppx::Buffer::onHeap)
+{
+	auto result = cppx::Buffer(manager, size);
+	auto data = reinterpret_cast<std::uint8_t *>(result.data());
+	std::uint32_t state = 0x12345678u;
+
+	for (std::size_t i = 0; i < size; ++i) {
+		state = state * 1103515245u + 12345u;
+		data[i] = static_cast<std::uint8_t>(state >> 24);
+	}
+
+	return result;
+}
+
+//! @brief Word-salad text, compressible like typical payloads
+inline cppx::Buffer text(std::size_t size, const cppx::BufferManager *manager = cppx::Buffer::onHeap)
+{
+	static const std::string s_words[] = {"buffer ", "manager ", "core ", "the ", "preallocated ", "heap ", "stack ", "request\n"};
+
+	auto result = cppx::Buffer(manager, size);
+	auto data = reinterpret_cast<std::uint8_t *>(result.data());
+	std::uint32_t state = 0x9E3779B9u;
+
+	for (std::size_t i = 0; i < size;) {
+		state = state * 1103515245u + 12345u;
+		const auto &word = s_words[(state >> 16) % 8];
+
+		for (std::size_t j = 0; j < word.size() && i < size; ++j, ++i)
+			data[i] = static_cast<std::uint8_t>(word[j]);
+	}
+
+	return result;
+}
+
+//! @brief Arguments: every size crossed with every manager
+inline void sizesAndManagers(benchmark::internal::Benchmark *benchmark)
+{
+	benchmark->ArgsProduct({{small_size, medium_size, large_size}, benchmark::CreateDenseRange(0, manager_count - 1, 1)});
+}
+
+inline void sizes(benchmark::internal::Benchmark *benchmark)
+{
+	benchmark->Arg(small_size)->Arg(medium_size)->Arg(large_size);
+}
+
+} // namespace bench
+
+#endif // !defined(CPPX_BENCH_COMMON_H)
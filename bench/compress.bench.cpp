@@ -0,0 +1,70 @@
+#include <benchmark/benchmark.h>
+
+#include "common.hpp"
+#include "cppxCompress.hpp"
+
+using cppx::Buffer;
+using cppx::Compression;
+
+namespace {
+Buffer sample(std::int64_t kind, std::size_t size)
+{
+	return kind == 0 ? bench::text(size) : bench::noise(size);
+}
+
+const char *sampleName(std::int64_t kind)
+{
+	return kind == 0 ? "text" : "noise";
+}
+} // namespace
+
+static void BM_Compress(benchmark::State &state)
+{
+	const auto source = sample(state.range(1), static_cast<std::size_t>(state.range(0)));
+	std::size_t compressedSize = 0;
+
+	for (auto _ : state) {
+		auto compressed = Compression::compress(source);
+		compressedSize = compressed.size();
+		benchmark::DoNotOptimize(compressed.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+	state.counters["ratio"] = double(source.size()) / double(compressedSize);
+	state.SetLabel(sampleName(state.range(1)));
+}
+BENCHMARK(BM_Compress)->ArgsProduct({{bench::medium_size, bench::large_size, 16 << 20}, {0, 1}});
+
+static void BM_Decompress(benchmark::State &state)
+{
+	const auto compressed = Compression::compress(sample(state.range(1), static_cast<std::size_t>(state.range(0))));
+
+	for (auto _ : state) {
+		auto decompressed = Compression::decompress(compressed);
+		benchmark::DoNotOptimize(decompressed.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+	state.SetLabel(sampleName(state.range(1)));
+}
+BENCHMARK(BM_Decompress)->ArgsProduct({{bench::medium_size, bench::large_size, 16 << 20}, {0, 1}});
+
+static void BM_CompressStream(benchmark::State &state)
+{
+	const auto source = bench::text(16 << 20);
+	const auto chunk = static_cast<std::size_t>(state.range(0));
+
+	for (auto _ : state) {
+		cppx::CompressStream stream;
+		std::size_t compressedSize = 0;
+
+		for (std::size_t offset = 0; offset < source.size(); offset += chunk)
+			compressedSize += stream.write(source.range(offset, offset + chunk, Buffer::onStack)).size();
+
+		compressedSize += stream.flush().size();
+		benchmark::DoNotOptimize(compressedSize);
+	}
+
+	state.SetBytesProcessed(state.iterations() * source.size());
+}
+BENCHMARK(BM_CompressStream)->Arg(bench::medium_size)->Arg(bench::large_size);
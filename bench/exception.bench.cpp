@@ -0,0 +1,54 @@
+#include <benchmark/benchmark.h>
+
+#include "cppxBuffer.hpp"
+#include "cppxException.hpp"
+
+using cppx::Exception;
+
+static void BM_ExceptionConstruct(benchmark::State &state)
+{
+	for (auto _ : state) {
+		auto exception = Exception("function", "description");
+		benchmark::DoNotOptimize(&exception);
+	}
+}
+BENCHMARK(BM_ExceptionConstruct);
+
+static void BM_ExceptionMakeCallString(benchmark::State &state)
+{
+	for (auto _ : state) {
+		auto callString = Exception::makeCallString("function", std::size_t(10), 0.5f, "text");
+		benchmark::DoNotOptimize(callString.data());
+	}
+}
+BENCHMARK(BM_ExceptionMakeCallString);
+
+static void BM_ExceptionCallstack(benchmark::State &state)
+{
+	const auto depth = state.range(0);
+
+	for (auto _ : state) {
+		auto exception = Exception("function0", "description");
+
+		for (std::int64_t i = 1; i < depth; ++i)
+			exception = Exception("function", exception);
+
+		benchmark::DoNotOptimize(&exception);
+	}
+}
+BENCHMARK(BM_ExceptionCallstack)->Arg(1)->Arg(4)->Arg(16);
+
+static void BM_ExceptionThrowCatch(benchmark::State &state)
+{
+	const auto buffer = cppx::Buffer::Heap(4);
+
+	for (auto _ : state) {
+		try {
+			benchmark::DoNotOptimize(buffer.at(10));
+		}
+		catch (const Exception &exception) {
+			benchmark::DoNotOptimize(&exception);
+		}
+	}
+}
+BENCHMARK(BM_ExceptionThrowCatch);
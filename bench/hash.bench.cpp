@@ -0,0 +1,94 @@
+#include <benchmark/benchmark.h>
+
+#include <unordered_map>
+#include <vector>
+
+#include "common.hpp"
+#include "cppxHash.hpp"
+
+using cppx::Buffer;
+
+namespace {
+//! @brief The byte-by-byte hasher the std::hash specialization replaces
+struct AtHasher {
+	std::size_t operator()(const Buffer &buffer) const
+	{
+		std::size_t hash = 14695981039346656037ull;
+
+		for (std::size_t i = 0; i < buffer.size(); ++i)
+			hash = (hash ^ buffer.at(i)) * 1099511628211ull;
+
+		return hash;
+	}
+};
+
+std::vector<Buffer> makeKeys(std::size_t count, std::size_t size)
+{
+	std::vector<Buffer> keys;
+	const auto pool = bench::noise(count + size);
+
+	for (std::size_t i = 0; i < count; ++i)
+		keys.push_back(pool.range(i, i + size));
+
+	return keys;
+}
+} // namespace
+
+static void BM_HashBuffer(benchmark::State &state)
+{
+	const auto source = bench::noise(static_cast<std::size_t>(state.range(0)));
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(cppx::Hasher::hash(source));
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HashBuffer)->Arg(16)->Apply(bench::sizes);
+
+static void BM_HashBufferAt(benchmark::State &state)
+{
+	const auto source = bench::noise(static_cast<std::size_t>(state.range(0)));
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(AtHasher()(source));
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_HashBufferAt)->Arg(16)->Apply(bench::sizes);
+
+static void BM_HashIncremental(benchmark::State &state)
+{
+	const auto source = bench::noise(bench::large_size);
+	const auto chunk = static_cast<std::size_t>(state.range(0));
+
+	for (auto _ : state) {
+		cppx::Hasher hasher;
+
+		for (std::size_t offset = 0; offset < source.size(); offset += chunk)
+			hasher.update(reinterpret_cast<const std::uint8_t *>(source.data()) + offset, chunk);
+
+		benchmark::DoNotOptimize(hasher.digest());
+	}
+
+	state.SetBytesProcessed(state.iterations() * bench::large_size);
+}
+BENCHMARK(BM_HashIncremental)->Arg(64)->Arg(4096);
+
+template <typename Hash>
+static void BM_HashMapLookup(benchmark::State &state)
+{
+	const auto keys = makeKeys(10000, static_cast<std::size_t>(state.range(0)));
+
+	std::unordered_map<Buffer, std::size_t, Hash> map;
+	for (std::size_t i = 0; i < keys.size(); ++i)
+		map[keys[i]] = i;
+
+	std::size_t i = 0;
+
+	for (auto _ : state) {
+		benchmark::DoNotOptimize(map.find(keys[i]));
+		i = (i + 1) % keys.size();
+	}
+}
+BENCHMARK_TEMPLATE(BM_HashMapLookup, std::hash<Buffer>)->Arg(16)->Arg(256);
+BENCHMARK_TEMPLATE(BM_HashMapLookup, AtHasher)->Arg(16)->Arg(256);
@@ -0,0 +1,112 @@
+#include <benchmark/benchmark.h>
+
+#include <string>
+#include <vector>
+
+#include "common.hpp"
+#include "cppxBuffer.hpp"
+#include "cppxInternPool.hpp"
+
+using cppx::Buffer;
+using cppx::InternPool;
+
+namespace {
+constexpr const std::size_t distinct_keys = 1024;
+
+//! @brief Header-like payloads; the same keys repeat across calls
+const std::vector<Buffer> &keys()
+{
+	static const std::vector<Buffer> result = []() {
+		std::vector<Buffer> keys;
+
+		for (std::size_t i = 0; i < distinct_keys; ++i) {
+			const auto key = "x-request-header-" + std::to_string(i * 7919);
+			keys.push_back(Buffer::HeapFrom((void *)key.data(), key.size()));
+		}
+
+		return keys;
+	}();
+
+	return result;
+}
+} // namespace
+
+static void BM_InternPoolIntern(benchmark::State &state)
+{
+	static InternPool pool;
+	const auto &payloads = keys();
+	std::size_t i = static_cast<std::size_t>(state.thread_index()) * 131;
+
+	for (auto _ : state) {
+		auto interned = pool.intern(payloads[i++ % distinct_keys]);
+		benchmark::DoNotOptimize(interned.data());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+#ifdef CPPX_BUFFER_ATOMIC
+BENCHMARK(BM_InternPoolIntern)->Threads(1)->Threads(4)->Threads(8);
+#else
+// interned buffers are shared, so more threads need atomic reference counts
+BENCHMARK(BM_InternPoolIntern);
+#endif
+
+// keeping every payload as a copy of its own
+static void BM_InternPoolCopyEach(benchmark::State &state)
+{
+	const auto &payloads = keys();
+	std::size_t i = 0;
+
+	for (auto _ : state) {
+		auto copy = payloads[i++ % distinct_keys].clone();
+		benchmark::DoNotOptimize(copy.data());
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_InternPoolCopyEach);
+
+static void BM_InternPoolFootprint(benchmark::State &state)
+{
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto &payloads = keys();
+	std::size_t pooled = 0, copied = 0;
+
+	for (auto _ : state) {
+		InternPool pool;
+		std::vector<Buffer> held;
+		held.reserve(count);
+
+		for (std::size_t i = 0; i < count; ++i) {
+			held.push_back(pool.intern(payloads[i % distinct_keys]));
+			copied += payloads[i % distinct_keys].size();
+		}
+
+		pooled += pool.bytes();
+	}
+
+	state.counters["pooled"] = benchmark::Counter(static_cast<double>(pooled), benchmark::Counter::kAvgIterations, benchmark::Counter::kIs1024);
+	state.counters["copied"] = benchmark::Counter(static_cast<double>(copied), benchmark::Counter::kAvgIterations, benchmark::Counter::kIs1024);
+}
+BENCHMARK(BM_InternPoolFootprint)->Arg(100000);
+
+static void BM_InternPoolPointerEquality(benchmark::State &state)
+{
+	InternPool pool;
+	const auto left = pool.intern(keys()[5]);
+	const auto right = pool.intern(keys()[5].clone());
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(left.data() == right.data());
+}
+BENCHMARK(BM_InternPoolPointerEquality);
+
+static void BM_InternPoolContentEquality(benchmark::State &state)
+{
+	const auto left = keys()[5];
+	const auto right = keys()[5].clone();
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(left == right);
+}
+BENCHMARK(BM_InternPoolContentEquality);
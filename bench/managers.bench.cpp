@@ -0,0 +1,71 @@
+#include <benchmark/benchmark.h>
+
+#include "common.hpp"
+#include "cppxBuffer.hpp"
+#include "cppxManagers.hpp"
+
+using cppx::Buffer;
+using cppx::Managers;
+
+namespace {
+constexpr const std::size_t scan_size = std::size_t(256) << 20;
+
+const cppx::BufferManager *scanManager(std::int64_t index)
+{
+	static const cppx::BufferManager nodeZero = Managers::nodeManager(0);
+	const cppx::BufferManager *const managers[] = {Buffer::onHeap, Managers::onHugePages, Managers::onInterleaved, &nodeZero};
+
+	return managers[index];
+}
+
+void scanManagers(benchmark::internal::Benchmark *benchmark)
+{
+	for (std::int64_t i = 0; i < 4; ++i)
+		benchmark->Arg(i);
+}
+} // namespace
+
+static void BM_ManagerSequentialScan(benchmark::State &state)
+{
+	const auto manager = scanManager(state.range(0));
+	const auto buffer = bench::noise(scan_size, manager);
+	const auto data = reinterpret_cast<const std::uint64_t *>(buffer.data());
+
+	for (auto _ : state) {
+		std::uint64_t sum = 0;
+
+		for (std::size_t i = 0; i < scan_size / sizeof(std::uint64_t); ++i)
+			sum += data[i];
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetBytesProcessed(state.iterations() * scan_size);
+	state.SetLabel(manager->name);
+}
+BENCHMARK(BM_ManagerSequentialScan)->Apply(scanManagers)->Unit(benchmark::kMillisecond);
+
+static void BM_ManagerRandomScan(benchmark::State &state)
+{
+	constexpr const std::size_t reads = std::size_t(1) << 22;
+
+	const auto manager = scanManager(state.range(0));
+	const auto buffer = bench::noise(scan_size, manager);
+	const auto data = reinterpret_cast<const std::uint8_t *>(buffer.data());
+
+	for (auto _ : state) {
+		std::uint64_t sum = 0, index = 0x9E3779B97F4A7C15ull;
+
+		// each read depends on the last one, so the TLB and cache misses are not overlapped
+		for (std::size_t i = 0; i < reads; ++i) {
+			index = index * 6364136223846793005ull + 1442695040888963407ull + sum;
+			sum += data[(index >> 20) % scan_size];
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetItemsProcessed(state.iterations() * reads);
+	state.SetLabel(manager->name);
+}
+BENCHMARK(BM_ManagerRandomScan)->Apply(scanManagers)->Unit(benchmark::kMillisecond);
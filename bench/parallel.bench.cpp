@@ -0,0 +1,96 @@
+#include <benchmark/benchmark.h>
+
+#include <thread>
+
+#include "common.hpp"
+#include "cppxParallel.hpp"
+
+using cppx::Buffer;
+using cppx::Parallel;
+
+namespace {
+constexpr const std::size_t scaling_size = std::size_t(256) << 20;
+
+//! @brief Thread counts from 1 to the hardware concurrency, doubling
+void threadCounts(benchmark::internal::Benchmark *benchmark)
+{
+	const auto hardware = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1;
+
+	for (unsigned threads = 1; threads < hardware; threads *= 2)
+		benchmark->Arg(threads);
+
+	benchmark->Arg(hardware)->UseRealTime()->Unit(benchmark::kMillisecond);
+}
+
+const Buffer &source()
+{
+	static const auto s_source = bench::noise(scaling_size);
+	return s_source;
+}
+} // namespace
+
+static void BM_ParallelClone(benchmark::State &state)
+{
+	const auto policy = Parallel{static_cast<std::size_t>(state.range(0))};
+
+	for (auto _ : state) {
+		auto result = source().clone(policy);
+		benchmark::DoNotOptimize(result.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * scaling_size);
+}
+BENCHMARK(BM_ParallelClone)->Apply(threadCounts);
+
+static void BM_ParallelReverse(benchmark::State &state)
+{
+	const auto policy = Parallel{static_cast<std::size_t>(state.range(0))};
+
+	for (auto _ : state) {
+		auto result = source().reverse(policy);
+		benchmark::DoNotOptimize(result.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * scaling_size);
+}
+BENCHMARK(BM_ParallelReverse)->Apply(threadCounts);
+
+static void BM_ParallelCompare(benchmark::State &state)
+{
+	const auto policy = Parallel{static_cast<std::size_t>(state.range(0))};
+	const auto other = source().clone(policy);
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(source().compare(other, policy));
+
+	state.SetBytesProcessed(state.iterations() * scaling_size);
+}
+BENCHMARK(BM_ParallelCompare)->Apply(threadCounts);
+
+static void BM_ParallelInsert(benchmark::State &state)
+{
+	const auto policy = Parallel{static_cast<std::size_t>(state.range(0))};
+	const auto value = bench::noise(bench::large_size);
+
+	for (auto _ : state) {
+		auto result = source().insert(scaling_size / 2, value, policy);
+		benchmark::DoNotOptimize(result.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * (scaling_size + bench::large_size));
+}
+BENCHMARK(BM_ParallelInsert)->Apply(threadCounts);
+
+static void BM_ParallelRepresent(benchmark::State &state)
+{
+	const auto policy = Parallel{static_cast<std::size_t>(state.range(0))};
+	const auto smaller = source().range(0, scaling_size / 8, Buffer::onStack);
+
+	for (auto _ : state) {
+		auto result = smaller.represent(Buffer::HEX, policy);
+		benchmark::DoNotOptimize(result.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * (scaling_size / 8));
+}
+BENCHMARK(BM_ParallelRepresent)->Apply(threadCounts);
@@ -0,0 +1,107 @@
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "common.hpp"
+#include "cppxBuffer.hpp"
+#include "cppxPool.hpp"
+
+using cppx::Buffer;
+using cppx::BufferPool;
+
+namespace {
+//! @brief Buffers a handler holds at once before dropping them all
+constexpr const std::size_t held_count = 16;
+
+const std::vector<std::size_t> &blockSizes()
+{
+	static const std::vector<std::size_t> s_sizes = {1 << 10, 4 << 10, 16 << 10, cppx::BufferCore::max_preall};
+	return s_sizes;
+}
+
+//! @brief One pool per block size, shared by the benchmark's threads
+BufferPool &pool(std::size_t size)
+{
+	static const auto s_pools = []() {
+		std::vector<std::unique_ptr<BufferPool>> result;
+
+		for (const auto blockSize : blockSizes())
+			result.emplace_back(new BufferPool(blockSize));
+
+		return result;
+	}();
+
+	for (const auto &candidate : s_pools)
+		if (candidate->blockSize() == size)
+			return *candidate;
+
+	return *s_pools.front();
+}
+
+/**
+ * @brief Each iteration acquires a buffer, writes a few bytes into it and drops the oldest one
+ * @details Every thread keeps held_count buffers alive, like request handlers
+ *          that overlap, so blocks are not simply handed back and forth.
+ */
+template <typename Acquire>
+void churn(benchmark::State &state, Acquire acquire)
+{
+	std::vector<Buffer> held(held_count);
+	const auto payload = bench::noise(64);
+	std::size_t next = 0;
+
+	for (auto _ : state) {
+		auto buffer = acquire();
+		buffer.selfAppend(payload);
+		benchmark::DoNotOptimize(buffer.data());
+
+		held[next] = std::move(buffer);
+		next = (next + 1) % held_count;
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+
+void sizesAndThreads(benchmark::internal::Benchmark *benchmark)
+{
+	for (const auto size : blockSizes())
+		benchmark->Arg(static_cast<std::int64_t>(size));
+
+	benchmark->ThreadRange(1, 8)->UseRealTime();
+}
+} // namespace
+
+static void BM_PoolChurnHeapPreall(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+	churn(state, [size]() { return Buffer::HeapPreall(size); });
+}
+BENCHMARK(BM_PoolChurnHeapPreall)->Apply(sizesAndThreads);
+
+static void BM_PoolChurnAcquire(benchmark::State &state)
+{
+	auto &source = pool(static_cast<std::size_t>(state.range(0)));
+	churn(state, [&source]() { return source.acquire(); });
+}
+BENCHMARK(BM_PoolChurnAcquire)->Apply(sizesAndThreads);
+
+// the core alone, from new and delete as on managers without coreAlloc; what recycling cores saves acquire()
+static void BM_PoolChurnCoreOnly(benchmark::State &state)
+{
+	std::vector<Buffer> held(held_count);
+	std::uint8_t scratch[64];
+	std::size_t next = 0;
+
+	for (auto _ : state) {
+		auto buffer = Buffer::Stack(scratch, sizeof(scratch));
+		benchmark::DoNotOptimize(buffer.data());
+
+		held[next] = std::move(buffer);
+		next = (next + 1) % held_count;
+	}
+
+	state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PoolChurnCoreOnly)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,220 @@
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+#include "common.hpp"
+#include "cppxBuffer.hpp"
+#include "cppxQueue.hpp"
+
+using cppx::Buffer;
+using cppx::BufferQueue;
+using cppx::SpscBufferQueue;
+
+namespace {
+constexpr const std::size_t queue_capacity = 1024;
+constexpr const std::size_t payload_size = 4096;
+
+//! @brief The std::mutex + std::deque hand-off the lock-free queues replace, bounded the same way
+class MutexQueue {
+private:
+	std::mutex m_mutex;
+	std::deque<Buffer> m_items;
+	std::size_t m_capacity;
+
+public:
+	explicit MutexQueue(std::size_t capacity) : m_capacity(capacity) {}
+
+	bool tryPush(Buffer &&value)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (m_items.size() >= m_capacity)
+			return false;
+
+		m_items.push_back(std::move(value));
+		return true;
+	}
+
+	bool tryPop(Buffer &value)
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+
+		if (m_items.empty())
+			return false;
+
+		value = std::move(m_items.front());
+		m_items.pop_front();
+		return true;
+	}
+
+	void push(Buffer &&value)
+	{
+		while (!tryPush(std::move(value)))
+			std::this_thread::yield();
+	}
+
+	Buffer pop()
+	{
+		Buffer result;
+
+		while (!tryPop(result))
+			std::this_thread::yield();
+
+		return result;
+	}
+};
+
+//! @brief The old hand-off: a private copy of every buffer goes through the mutex queue
+class CloningQueue : public MutexQueue {
+public:
+	using MutexQueue::MutexQueue;
+
+	void push(Buffer &&value)
+	{
+		MutexQueue::push(value.clone());
+	}
+};
+
+/**
+ * @brief Even threads produce a fresh buffer per iteration, odd threads consume one
+ * @details Every thread runs the same number of iterations, so with as many
+ *          producers as consumers everything pushed is popped.
+ */
+template <typename Queue>
+void handOff(benchmark::State &state)
+{
+	static Queue *queue = nullptr;
+
+	if (state.thread_index() == 0)
+		queue = new Queue(queue_capacity);
+
+	const bool producer = state.thread_index() % 2 == 0;
+
+	for (auto _ : state) {
+		if (producer) {
+			queue->push(Buffer::Heap(payload_size));
+		}
+		else {
+			const auto item = queue->pop();
+			benchmark::DoNotOptimize(item.data());
+		}
+	}
+
+	if (producer)
+		state.SetItemsProcessed(state.iterations());
+
+	if (state.thread_index() == 0)
+		delete queue;
+}
+
+//! @brief A push and a pop on one thread: the cost of the queue itself, with no waiting
+template <typename Queue>
+void pushPop(benchmark::State &state)
+{
+	Queue queue(queue_capacity);
+	auto item = bench::noise(payload_size);
+
+	for (auto _ : state) {
+		queue.tryPush(std::move(item));
+		queue.tryPop(item);
+	}
+
+	benchmark::DoNotOptimize(item.data());
+	state.SetItemsProcessed(state.iterations());
+}
+
+//! @brief One buffer bounces between two threads; the time per iteration is a round trip
+template <typename Queue>
+void pingPong(benchmark::State &state)
+{
+	Queue there(queue_capacity);
+	Queue back(queue_capacity);
+	std::atomic<bool> stop(false);
+
+	std::thread echo([&]() {
+		Buffer item;
+
+		while (!stop.load(std::memory_order_relaxed)) {
+			if (!there.tryPop(item)) {
+				std::this_thread::yield();
+				continue;
+			}
+
+			back.push(std::move(item));
+		}
+	});
+
+	auto item = bench::noise(payload_size);
+
+	for (auto _ : state) {
+		there.push(std::move(item));
+		item = back.pop();
+	}
+
+	stop.store(true);
+	echo.join();
+}
+} // namespace
+
+static void BM_QueueHandOffMutexClone(benchmark::State &state)
+{
+	handOff<CloningQueue>(state);
+}
+BENCHMARK(BM_QueueHandOffMutexClone)->Threads(2)->Threads(4)->UseRealTime();
+
+static void BM_QueueHandOffMutex(benchmark::State &state)
+{
+	handOff<MutexQueue>(state);
+}
+BENCHMARK(BM_QueueHandOffMutex)->Threads(2)->Threads(4)->UseRealTime();
+
+static void BM_QueueHandOffMpmc(benchmark::State &state)
+{
+	handOff<BufferQueue>(state);
+}
+BENCHMARK(BM_QueueHandOffMpmc)->Threads(2)->Threads(4)->UseRealTime();
+
+static void BM_QueueHandOffSpsc(benchmark::State &state)
+{
+	handOff<SpscBufferQueue>(state);
+}
+BENCHMARK(BM_QueueHandOffSpsc)->Threads(2)->UseRealTime();
+
+static void BM_QueuePushPopMutex(benchmark::State &state)
+{
+	pushPop<MutexQueue>(state);
+}
+BENCHMARK(BM_QueuePushPopMutex);
+
+static void BM_QueuePushPopMpmc(benchmark::State &state)
+{
+	pushPop<BufferQueue>(state);
+}
+BENCHMARK(BM_QueuePushPopMpmc);
+
+static void BM_QueuePushPopSpsc(benchmark::State &state)
+{
+	pushPop<SpscBufferQueue>(state);
+}
+BENCHMARK(BM_QueuePushPopSpsc);
+
+static void BM_QueuePingPongMutex(benchmark::State &state)
+{
+	pingPong<MutexQueue>(state);
+}
+BENCHMARK(BM_QueuePingPongMutex)->UseRealTime();
+
+static void BM_QueuePingPongMpmc(benchmark::State &state)
+{
+	pingPong<BufferQueue>(state);
+}
+BENCHMARK(BM_QueuePingPongMpmc)->UseRealTime();
+
+static void BM_QueuePingPongSpsc(benchmark::State &state)
+{
+	pingPong<SpscBufferQueue>(state);
+}
+BENCHMARK(BM_QueuePingPongSpsc)->UseRealTime();
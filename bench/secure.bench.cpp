@@ -0,0 +1,103 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+#include "common.hpp"
+#include "cppxBuffer.hpp"
+#include "cppxSecure.hpp"
+
+using cppx::Buffer;
+using cppx::Secure;
+
+static void BM_SecureConstruct(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+
+	for (auto _ : state) {
+		auto buffer = Buffer(Secure::onSecure, size);
+		benchmark::DoNotOptimize(buffer.data());
+	}
+}
+BENCHMARK(BM_SecureConstruct)->Arg(32)->Arg(bench::small_size)->Arg(bench::medium_size)->Arg(bench::medium_size * 4);
+
+static void BM_SecureGrow(benchmark::State &state)
+{
+	const auto chunk = bench::noise(16);
+
+	for (auto _ : state) {
+		auto buffer = Buffer(Secure::onSecure);
+
+		for (int i = 0; i < 16; ++i)
+			buffer.selfAppend(chunk);
+
+		benchmark::DoNotOptimize(buffer.data());
+	}
+}
+BENCHMARK(BM_SecureGrow);
+
+static void BM_SecureEqual(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+	const auto left = bench::noise(size);
+	const auto right = left.clone();
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(Secure::equal(left, right));
+
+	state.SetBytesProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SecureEqual)->Arg(16)->Arg(32)->Arg(bench::small_size)->Arg(bench::medium_size);
+
+//! @brief Differing in the first byte; compare() stops there, Secure::equal() doesn't
+static void BM_SecureEqualEarlyDifference(benchmark::State &state)
+{
+	const auto size = static_cast<std::size_t>(state.range(0));
+	const auto left = bench::noise(size);
+	auto right = left.clone();
+	right[0] ^= 0xFF;
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(Secure::equal(left, right));
+}
+BENCHMARK(BM_SecureEqualEarlyDifference)->Arg(16)->Arg(bench::medium_size);
+
+/**
+ * @brief Times equal() on inputs differing nowhere, in the first byte and in the last byte
+ * @details The cases are interleaved, so drifts of the clock rate hit each
+ *          alike. The "spread" counter is the slowest median over the
+ *          fastest; close to 1 means the position of a difference doesn't
+ *          show in the timing.
+ */
+static void BM_SecureEqualTimingSpread(benchmark::State &state)
+{
+	constexpr const std::size_t size = 4096, calls = 64;
+
+	const auto reference = bench::noise(size);
+	std::vector<Buffer> candidates = {reference.clone(), reference.clone(), reference.clone()};
+	candidates[1][0] ^= 0x01;
+	candidates[2][size - 1] ^= 0x01;
+
+	std::vector<std::vector<double>> samples(candidates.size());
+
+	for (auto _ : state) {
+		for (std::size_t which = 0; which < candidates.size(); ++which) {
+			const auto start = std::chrono::steady_clock::now();
+
+			for (std::size_t call = 0; call < calls; ++call)
+				benchmark::DoNotOptimize(Secure::equal(reference, candidates[which]));
+
+			samples[which].push_back(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+		}
+	}
+
+	std::vector<double> medians;
+	for (auto &sample : samples) {
+		std::nth_element(sample.begin(), sample.begin() + sample.size() / 2, sample.end());
+		medians.push_back(sample[sample.size() / 2]);
+	}
+
+	state.counters["spread"] = *std::max_element(medians.begin(), medians.end()) / *std::min_element(medians.begin(), medians.end());
+}
+BENCHMARK(BM_SecureEqualTimingSpread);
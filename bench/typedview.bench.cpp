@@ -0,0 +1,105 @@
+#include <benchmark/benchmark.h>
+
+#include <cstring>
+
+#include "common.hpp"
+#include "cppxBuffer.hpp"
+#include "cppxTypedView.hpp"
+
+using cppx::Buffer;
+using cppx::TypedView;
+using cppx::UnalignedView;
+
+namespace {
+Buffer floats(std::size_t count)
+{
+	auto result = Buffer::Heap(count * sizeof(float));
+	TypedView<float> view(result);
+
+	for (std::size_t i = 0; i < count; ++i)
+		view[i] = static_cast<float>(i % 1024) * 0.25f;
+
+	return result;
+}
+} // namespace
+
+static void BM_TypedViewSum(benchmark::State &state)
+{
+	const auto buffer = floats(static_cast<std::size_t>(state.range(0)));
+
+	for (auto _ : state) {
+		const TypedView<const float> view(buffer);
+		float sum = 0;
+
+		for (const auto value : view)
+			sum += value;
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_TypedViewSum)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_UnalignedViewSum(benchmark::State &state)
+{
+	const auto buffer = floats(static_cast<std::size_t>(state.range(0)));
+
+	for (auto _ : state) {
+		const UnalignedView<const float> view(buffer);
+		float sum = 0;
+
+		for (std::size_t i = 0; i < view.size(); ++i)
+			sum += view.load(i);
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_UnalignedViewSum)->Arg(1 << 10)->Arg(1 << 20);
+
+// the element assembled from checked byte reads, as done without a view
+static void BM_ByteAccessSum(benchmark::State &state)
+{
+	const auto buffer = floats(static_cast<std::size_t>(state.range(0)));
+
+	for (auto _ : state) {
+		float sum = 0;
+
+		for (std::size_t i = 0; i < buffer.size(); i += sizeof(float)) {
+			std::uint8_t bytes[sizeof(float)];
+			for (std::size_t j = 0; j < sizeof(float); ++j)
+				bytes[j] = buffer.at(i + j);
+
+			float value;
+			std::memcpy(&value, bytes, sizeof(value));
+			sum += value;
+		}
+
+		benchmark::DoNotOptimize(sum);
+	}
+
+	state.SetBytesProcessed(state.iterations() * buffer.size());
+}
+BENCHMARK(BM_ByteAccessSum)->Arg(1 << 10)->Arg(1 << 20);
+
+static void BM_TypedViewAxpy(benchmark::State &state)
+{
+	const auto count = static_cast<std::size_t>(state.range(0));
+	const auto x = floats(count);
+	auto y = floats(count);
+
+	for (auto _ : state) {
+		const TypedView<const float> in(x);
+		const TypedView<float> out(y);
+
+		for (std::size_t i = 0; i < count; ++i)
+			out[i] = 0.5f * in[i] + out[i];
+
+		benchmark::DoNotOptimize(y.data());
+	}
+
+	state.SetBytesProcessed(state.iterations() * 2 * x.size());
+}
+BENCHMARK(BM_TypedViewAxpy)->Arg(1 << 10)->Arg(1 << 20);
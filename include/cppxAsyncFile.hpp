@@ -0,0 +1,359 @@
+#ifndef CPPX_ASYNCFILE_H
+#define CPPX_ASYNCFILE_H
+
+#include "cppxBuffer.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#include <coroutine>
+#define CPPX_ASYNCFILE_COROUTINES
+#endif
+#endif
+
+namespace cppx {
+
+/**
+ * @brief Result of an asynchronous file operation
+ * @details Waited for with get(), or awaited with co_await when compiled as
+ *          C++20. The result is taken once. A continuation, given with then()
+ *          or by co_await, runs on the engine thread that finished the
+ *          operation, or right away if it is already done; it must not block
+ *          on other operations of the same engine.
+ */
+template <typename T>
+class IoTask {
+public:
+	struct State {
+		std::mutex mutex;
+		std::condition_variable finished;
+		bool done = false;
+
+		T value{};
+		std::exception_ptr error;
+		std::function<void()> continuation;
+
+		void complete(T result)
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			value = std::move(result);
+			finish(lock);
+		}
+
+		void fail(std::exception_ptr failure)
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			error = std::move(failure);
+			finish(lock);
+		}
+
+		//! @brief Stores |next| to run when the operation finishes; false if it already has
+		bool defer(std::function<void()> next)
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			if (done)
+				return false;
+
+			continuation = std::move(next);
+			return true;
+		}
+
+	private:
+		void finish(std::unique_lock<std::mutex> &lock)
+		{
+			done = true;
+			auto next = std::move(continuation);
+
+			lock.unlock();
+			finished.notify_all();
+
+			if (next)
+				next();
+		}
+	};
+
+private:
+	std::shared_ptr<State> m_state;
+
+public:
+	explicit IoTask(std::shared_ptr<State> state) : m_state(std::move(state)) {}
+
+	bool ready() const
+	{
+		std::lock_guard<std::mutex> lock(m_state->mutex);
+		return m_state->done;
+	}
+
+	void wait() const
+	{
+		std::unique_lock<std::mutex> lock(m_state->mutex);
+		m_state->finished.wait(lock, [this]() { return m_state->done; });
+	}
+
+	/**
+	 * @brief Waits for the operation and takes its result
+	 * @throw Exception if the operation failed
+	 */
+	T get()
+	{
+		wait();
+
+		if (m_state->error)
+			std::rethrow_exception(m_state->error);
+
+		return std::move(m_state->value);
+	}
+
+	//! @brief Runs |next| once the operation is done; replaces an earlier continuation
+	void then(std::function<void()> next)
+	{
+		if (!m_state->defer(next))
+			next();
+	}
+
+#ifdef CPPX_ASYNCFILE_COROUTINES
+	bool await_ready() const { return ready(); }
+
+	bool await_suspend(std::coroutine_handle<> handle)
+	{
+		return m_state->defer([handle]() { handle.resume(); });
+	}
+
+	T await_resume() { return get(); }
+#endif
+};
+
+enum class IoBackend : std::uint8_t {
+	//! @brief io_uring where the kernel supports it, the thread pool otherwise
+	automatic,
+	uring,
+	threads
+};
+
+struct IoOptions {
+	IoBackend backend = IoBackend::automatic;
+
+	//! @brief Transfers in flight on the ring; the rest queue up behind them
+	std::size_t depth = 64;
+
+	//! @brief Threads of the thread-pool backend
+	std::size_t threads = 4;
+
+	//! @brief Bytes per transfer when read() and write() split a file
+	std::size_t chunk = std::size_t(1) << 20;
+};
+
+/**
+ * @brief Runs positional reads and writes off the calling thread
+ * @details Backed by an io_uring instance with a thread reaping its
+ *          completions, or by a pool of threads making blocking calls.
+ *          Transfers are complete: short reads and writes are continued
+ *          until the end of the range, or of the file for reads. Opening
+ *          and sizing files happens on the calling thread. The destructor
+ *          waits for the transfers in flight.
+ */
+class IoEngine {
+public:
+	//! @brief Called once per transfer with the bytes moved and 0, or with an errno value; must not throw
+	using Completion = std::function<void(std::size_t, int)>;
+
+	struct Engine;
+
+private:
+	std::unique_ptr<Engine> m_engine;
+	std::size_t m_chunk;
+
+public:
+	/**
+	 * @brief Starts the engine's threads
+	 * @throw Exception if io_uring is asked for and the kernel doesn't support it
+	 */
+	explicit IoEngine(const IoOptions &options = IoOptions());
+	~IoEngine();
+
+	IoEngine(const IoEngine &) = delete;
+	IoEngine &operator=(const IoEngine &) = delete;
+
+	IoBackend backend() const noexcept;
+
+	//! @brief True if this kernel lets an engine use io_uring
+	static bool uringAvailable() noexcept;
+
+	//! @brief Reads |size| bytes at |offset| of |fd| into |data|, which must stay valid until |done| is called
+	void submitRead(int fd, void *data, std::size_t size, std::uint64_t offset, Completion done);
+
+	//! @brief Writes |size| bytes of |data| at |offset| of |fd|, which must stay valid until |done| is called
+	void submitWrite(int fd, const void *data, std::size_t size, std::uint64_t offset, Completion done);
+
+	/**
+	 * @brief Reads the whole regular file at |path| into a new buffer on |manager|
+	 * @details The file is read in chunks, all in flight at once. A file that
+	 *          shrinks meanwhile gives a shorter buffer.
+	 * @throw Exception if the file can't be opened, or is too large for a buffer
+	 */
+	[[nodiscard]] IoTask<Buffer> read(const std::string &path, const BufferManager *manager = Buffer::onHeap);
+
+	/**
+	 * @brief Replaces the file at |path| with the contents of |buffer|
+	 * @details The buffer is shared until the write is done; its data must not
+	 *          be changed in place meanwhile. Without CPPX_BUFFER_ATOMIC the
+	 *          engine writes a copy of it instead.
+	 * @throw Exception if the file can't be opened
+	 */
+	[[nodiscard]] IoTask<std::size_t> write(const std::string &path, const Buffer &buffer);
+};
+
+/**
+ * @brief Reads a file in consecutive pieces, each appended in place to a buffer
+ * @details Every read lands in the preallocated tail of its target, which is
+ *          grown when needed, so pieces are never copied. The offset moves on
+ *          when a read is started, so several may be in flight, each with a
+ *          target of its own that stays alive and untouched until it is done.
+ *          The reader must outlive its reads.
+ */
+class FileReader {
+private:
+	IoEngine &m_engine;
+	int m_fd;
+	std::uint64_t m_size;
+	std::uint64_t m_offset;
+
+public:
+	//! @throw Exception if the file can't be opened
+	FileReader(IoEngine &engine, const std::string &path);
+	~FileReader();
+
+	FileReader(const FileReader &) = delete;
+	FileReader &operator=(const FileReader &) = delete;
+
+	//! @brief Size of the file when it was opened
+	std::uint64_t size() const noexcept;
+	std::uint64_t offset() const noexcept;
+
+	/**
+	 * @brief Appends up to |bytes| of the file to |target|; the result is the bytes read, 0 at the end
+	 * @details At most BufferCore::max_preall bytes are read at a time. An
+	 *          empty target is put on the heap.
+	 * @throw Exception if the target can't be given a large enough tail
+	 */
+	[[nodiscard]] IoTask<std::size_t> readInto(Buffer &target, std::size_t bytes);
+};
+
+/**
+ * @brief Writes buffers one after another to a file
+ * @details The offset moves on when a write is started, so several may be in
+ *          flight. Each buffer is shared until its write is done. The writer
+ *          must outlive its writes.
+ */
+class FileWriter {
+private:
+	IoEngine &m_engine;
+	int m_fd;
+	std::uint64_t m_offset;
+
+public:
+	/**
+	 * @brief Opens |path| for writing, creating it; truncates it unless |append| is set
+	 * @throw Exception if the file can't be opened
+	 */
+	FileWriter(IoEngine &engine, const std::string &path, bool append = false);
+	~FileWriter();
+
+	FileWriter(const FileWriter &) = delete;
+	FileWriter &operator=(const FileWriter &) = delete;
+
+	std::uint64_t offset() const noexcept;
+
+	//! @brief Writes |buffer| at the offset, sharing or copying it like IoEngine::write; the result is its size
+	[[nodiscard]] IoTask<std::size_t> write(const Buffer &buffer);
+};
+
+struct PrefetchOptions {
+	//! @brief Bytes per chunk
+	std::size_t chunk = std::size_t(1) << 20;
+
+	//! @brief Chunks read ahead while the caller processes the current one
+	std::size_t depth = 2;
+};
+
+/**
+ * @brief Reads a file chunk by chunk, ahead of the caller
+ * @details While the caller processes the chunk next() returned, the engine
+ *          reads the following |depth| chunks, so processing and I/O overlap.
+ *          Chunks come from a pool: the reader keeps a reference to each one
+ *          it hands out, and reads into it again once the caller no longer
+ *          shares it. A scan that drops every chunk before asking for the
+ *          next allocates at most depth + 1 buffers of a whole chunk, plus one
+ *          for a shorter last chunk, however long the file.
+ *          Chunks must not be written to through data(). The destructor waits
+ *          for the reads in flight.
+ */
+class PrefetchReader {
+private:
+	struct Pending {
+		Buffer buffer;
+		std::shared_ptr<IoTask<std::size_t>::State> state;
+	};
+
+	IoEngine &m_engine;
+	std::size_t m_chunk;
+	std::size_t m_depth;
+	int m_fd;
+	std::uint64_t m_size;
+
+	//! @brief Offset of the next read to start
+	std::uint64_t m_requested;
+
+	std::deque<Pending> m_reads;
+
+	//! @brief Chunks handed out, and chunks ready to be read into again
+	std::vector<Buffer> m_lent;
+	std::vector<Buffer> m_free;
+	std::size_t m_allocations;
+
+	Buffer take();
+	void refill();
+
+	//! @brief Waits for the reads in flight and closes the file
+	void stop() noexcept;
+
+public:
+	/**
+	 * @brief Opens |path| and starts reading its first chunks
+	 * @throw Exception if the chunk size or depth is 0, a chunk is too large for a buffer, or the file can't be opened
+	 */
+	PrefetchReader(IoEngine &engine, const std::string &path, const PrefetchOptions &options = PrefetchOptions());
+	~PrefetchReader();
+
+	PrefetchReader(const PrefetchReader &) = delete;
+	PrefetchReader &operator=(const PrefetchReader &) = delete;
+
+	//! @brief Size of the file when it was opened
+	std::uint64_t size() const noexcept;
+
+	//! @brief Buffers allocated for chunks so far
+	std::size_t allocations() const noexcept;
+
+	/**
+	 * @brief Returns the next chunk, waiting for its read if needed; an empty buffer at the end
+	 * @details The last chunk may be shorter.
+	 * @throw Exception if the read failed
+	 */
+	[[nodiscard]] Buffer next();
+};
+
+} // namespace cppx
+
+#endif // !defined(CPPX_ASYNCFILE_H)
@@ -0,0 +1,75 @@
+#ifndef CPPX_BITS_H
+#define CPPX_BITS_H
+
+#include "cppxBuffer.hpp"
+
+#include <cstddef>
+
+namespace cppx {
+
+/**
+ * @brief Bitmap operations on buffers
+ * @details Bit i is bit (i % 8) of byte (i / 8), counting from the least
+ *          significant bit, so a buffer reads as a little-endian integer.
+ *          Loops work on 64-bit words. The self* operations, set and clear
+ *          modify the buffer in place and detach it first if it is shared.
+ */
+class Bits {
+public:
+	constexpr static const std::size_t npos = std::size_t(~0);
+
+public:
+	/**
+	 * @throw Exception if the sizes differ, or the manager can't allocate
+	 */
+	[[nodiscard]] static Buffer bitAnd(const Buffer &left, const Buffer &right, const BufferManager *manager = nullptr);
+	[[nodiscard]] static Buffer bitOr(const Buffer &left, const Buffer &right, const BufferManager *manager = nullptr);
+	[[nodiscard]] static Buffer bitXor(const Buffer &left, const Buffer &right, const BufferManager *manager = nullptr);
+	[[nodiscard]] static Buffer bitNot(const Buffer &buffer, const BufferManager *manager = nullptr);
+
+	/**
+	 * @throw Exception if the sizes differ, or |target| can't be modified
+	 */
+	static Buffer &selfAnd(Buffer &target, const Buffer &other);
+	static Buffer &selfOr(Buffer &target, const Buffer &other);
+	static Buffer &selfXor(Buffer &target, const Buffer &other);
+	static Buffer &selfNot(Buffer &target);
+
+	static std::size_t popcount(const Buffer &buffer) noexcept;
+
+	//! @brief Index of the lowest set bit, or npos if there is none
+	static std::size_t findFirstSet(const Buffer &buffer) noexcept;
+
+	//! @brief Index of the lowest unset bit, or npos if there is none
+	static std::size_t findFirstUnset(const Buffer &buffer) noexcept;
+
+	/**
+	 * @throw Exception if |bit| is beyond the end of the buffer
+	 */
+	static bool test(const Buffer &buffer, std::size_t bit);
+
+	/**
+	 * @throw Exception if |bit| is beyond the end of the buffer, or |buffer| can't be modified
+	 */
+	static void set(Buffer &buffer, std::size_t bit, bool value = true);
+	static void clear(Buffer &buffer, std::size_t bit);
+
+	/**
+	 * @brief Moves every bit |count| places towards the end; bits shifted past it are lost
+	 * @throw Exception if the manager can't allocate
+	 */
+	[[nodiscard]] static Buffer shiftLeft(const Buffer &buffer, std::size_t count, const BufferManager *manager = nullptr);
+
+	/**
+	 * @brief Moves every bit |count| places towards the start; bits shifted past it are lost
+	 * @throw Exception if the manager can't allocate
+	 */
+	[[nodiscard]] static Buffer shiftRight(const Buffer &buffer, std::size_t count, const BufferManager *manager = nullptr);
+
+	static Buffer &selfShiftLeft(Buffer &target, std::size_t count);
+	static Buffer &selfShiftRight(Buffer &target, std::size_t count);
+};
+
+} // namespace cppx
+
+#endif // !defined(CPPX_BITS_H)
@@ -1,21 +1,66 @@
 #ifndef CPPX_BUFFER_H
 #define CPPX_BUFFER_H
 
+#include <atomic>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <string>
+#include <utility>
+#include <vector>
+
+#ifdef CPPX_BUFFER_STATS
+#include <ostream>
+#endif
 
 namespace cppx {
 struct BufferFlags {
 	std::uint8_t memory : 1;
 	std::uint8_t modify : 1;
+
+	/**
+	 * @brief Copy-on-write; copies share the data until one of them is modified
+	 * @details The non-const at() and the self-modifying operations detach a shared
+	 *          buffer with a single copy first. Writes through data() or iterators
+	 *          are not tracked; call Buffer::selfDetach() before them.
+	 */
+	std::uint8_t cow : 1;
+};
+
+#ifdef CPPX_BUFFER_STATS
+/** @brief Snapshot of the usage counters of a BufferManager */
+struct BufferStats {
+	std::uint64_t allocations;
+	std::uint64_t releases;
+	std::uint64_t bytesLive;
+	std::uint64_t bytesPeak;
+	std::uint64_t reallocations;
+
+	//! @brief Payload copies made by clone, range and insert
+	std::uint64_t copies;
+	std::uint64_t bytesCopied;
+
+	std::uint64_t detaches;
+
+	//! @brief selfInsert calls that fit into / had to grow past the preallocated tail
+	std::uint64_t preallocationHits;
+	std::uint64_t preallocationMisses;
+
+	std::string toString() const;
 };
+#endif
 
 struct BufferManager {
 	using AllocateFunction = std::function<void *(std::size_t)>;
 	using DeallocateFunction = std::function<void(void *, std::size_t)>;
 
+	/**
+	 * @brief Resizes the block at the pointer from the first size to the second
+	 * @details Returns the possibly moved block with the common prefix kept, or
+	 *          nullptr on failure, leaving the original block valid.
+	 */
+	using ReallocateFunction = std::function<void *(void *, std::size_t, std::size_t)>;
+
 	static const AllocateFunction defaultAllocateFunction;
 	static const DeallocateFunction defaultReleaseFunction;
 
@@ -24,12 +69,66 @@ struct BufferManager {
 	AllocateFunction alloc;
 	DeallocateFunction release;
 
+	//! @brief Optional; managers without it grow by allocating, copying and releasing
+	ReallocateFunction reallocate = nullptr;
+
+	/**
+	 * @brief Optional; allocates memory that is already zeroed, like calloc
+	 * @details Lets large blocks come straight from fresh zero pages, which are
+	 *          not faulted in until written. Managers without it get a memset.
+	 */
+	AllocateFunction zeroAlloc = nullptr;
+
+	/**
+	 * @brief Optional; allocate and free the BufferCore of each buffer on the manager
+	 * @details Let a manager recycle cores along with its blocks. Managers
+	 *          without them get their cores from new and delete.
+	 */
+	AllocateFunction coreAlloc = nullptr;
+	DeallocateFunction coreRelease = nullptr;
+
 	std::string toString() const;
+
+#ifdef CPPX_BUFFER_STATS
+	struct Counters {
+		std::atomic<std::uint64_t> allocations{0};
+		std::atomic<std::uint64_t> releases{0};
+		std::atomic<std::uint64_t> bytesLive{0};
+		std::atomic<std::uint64_t> bytesPeak{0};
+		std::atomic<std::uint64_t> reallocations{0};
+		std::atomic<std::uint64_t> copies{0};
+		std::atomic<std::uint64_t> bytesCopied{0};
+		std::atomic<std::uint64_t> detaches{0};
+		std::atomic<std::uint64_t> preallocationHits{0};
+		std::atomic<std::uint64_t> preallocationMisses{0};
+
+		void allocated(std::size_t bytes) noexcept;
+		void released(std::size_t bytes) noexcept;
+		void reallocated(std::size_t from, std::size_t to) noexcept;
+		void copied(std::size_t bytes) noexcept;
+	};
+
+	mutable Counters counters;
+
+	BufferStats stats() const noexcept;
+	void resetStats() const noexcept;
+
+	//! @brief Writes the name and counters of the manager as a line to |stream|
+	void dumpStats(std::ostream &stream) const;
+#endif
 };
 
+struct Parallel;
+
 class BufferCore {
 public:
+#ifdef CPPX_BUFFER_ATOMIC
+	//! @brief Buffers and iterators sharing the core; atomic, so copies of one buffer may live on different threads
+	std::atomic<std::uint16_t> m_refcount;
+#else
+	//! @brief Buffers and iterators sharing the core; copies of one buffer stay on one thread at a time
 	std::uint16_t m_refcount;
+#endif
 	std::uint16_t m_preall;
 	std::uint32_t m_size;
 	std::uint8_t *m_address;
@@ -40,24 +139,45 @@ public:
 	constexpr static const std::size_t max_size = std::uint32_t(~0);
 	constexpr static const std::size_t max_preall = std::uint16_t(~0);
 
+#ifdef CPPX_BUFFER_ATOMIC
+	//! @brief Most references a core takes; copies past it get their own data. Kept below 2^16 for headroom
+	constexpr static const std::uint16_t max_refcount = std::uint16_t(~0) - 0xFF;
+#else
+	//! @brief Most references a core takes; copies past it get their own data
+	constexpr static const std::uint16_t max_refcount = std::uint16_t(~0);
+#endif
+
 private:
 	BufferCore(const BufferManager *manager, std::uint16_t preall = 0, std::uint32_t size = 0, std::uint8_t *address = nullptr);
 
 public:
 	~BufferCore() = default;
 
-	std::uint8_t *tryAllocateRaw(std::size_t bytes);
+	std::uint8_t *tryAllocateRaw(std::size_t bytes, bool zeroed = false);
+
+	//! @brief Resizes the data to |bytes| with the manager's reallocate; false if it has none or it fails
+	bool tryReallocateRaw(std::size_t bytes);
 	bool tryDeallocateRaw();
 	bool tryShare();
-	bool tryAllocate(std::size_t bytes);
+	bool tryAllocate(std::size_t bytes, bool zeroed = false);
 	bool tryDeallocate();
 
 	static void shareOrDetach(BufferCore *&core);
 
+	//! @brief Returns a new core with a copy of the data; |core| is left as it is
+	static BufferCore *duplicate(const BufferCore *core);
+
 	static void detach(BufferCore *&core);
 	static void create(BufferCore *&core, const BufferManager *manager, std::uint16_t preall = 0, std::uint32_t size = 0, std::uint8_t *address = nullptr);
+
+	//! @brief Frees |core| itself, not its data, the way create() allocated it
+	static void destroy(BufferCore *core) noexcept;
+
 	static void release(BufferCore *&core);
 	static void change(BufferCore *&core, BufferCore *const newcore);
+
+	//! @brief Releases |core| and takes over the reference held by a newly created |newcore|
+	static void adopt(BufferCore *&core, BufferCore *const newcore);
 };
 
 class Buffer {
@@ -68,32 +188,85 @@ public:
 	static const BufferManager staticManager;
 	static const BufferManager stackManager;
 	static const BufferManager heapManager;
+	static const BufferManager heapCowManager;
+
+	/**
+	 * @brief Manager of the buffers made by HeapBatch
+	 * @details Buffers are slices of a shared arena, which is freed with its last
+	 *          slice. Allocating on it creates an arena with a single slice.
+	 */
+	static const BufferManager arenaManager;
 
 	static constexpr const BufferManager *onStatic = &staticManager;
 	static constexpr const BufferManager *onStack = &stackManager;
 	static constexpr const BufferManager *onHeap = &heapManager;
+	static constexpr const BufferManager *onHeapCow = &heapCowManager;
+	static constexpr const BufferManager *onArena = &arenaManager;
+
+	//! @brief Pointer and size of data to copy into a buffer
+	using Span = std::pair<const void *, std::size_t>;
+
+	/**
+	 * @brief When selfErase gives the preallocated tail back to the manager
+	 * @details A buffer is trimmed once its preallocated bytes reach both
+	 *          |minimum| and |ratio| times its size. A ratio of 0 disables
+	 *          trimming, which is the default.
+	 */
+	struct TrimPolicy {
+		float ratio;
+		std::size_t minimum;
+	};
 
 private:
 	BufferCore *m_core;
 
+	static TrimPolicy s_trimPolicy;
+
+	void trimIfIdle();
+
 public:
 	constexpr Buffer() : m_core(nullptr) {}
 	Buffer(const BufferManager *manager, std::size_t size = 0);
 	Buffer(const BufferManager *manager, void *pointer, std::size_t size);
 	Buffer(const Buffer &other);
-	Buffer(Buffer &&other);
+	//! @brief Takes over the data of |other|, which is left empty
+	Buffer(Buffer &&other) noexcept;
 	~Buffer();
 
 	[[nodiscard]] static Buffer Heap(std::size_t size);
+
+	/**
+	 * @brief Creates an empty buffer with |size| bytes preallocated, at most BufferCore::max_preall
+	 * @throw Exception if the manager can't allocate
+	 */
+	[[nodiscard]] static Buffer Preall(const BufferManager *manager, std::size_t size);
 	[[nodiscard]] static Buffer HeapPreall(std::size_t size);
 	[[nodiscard]] static Buffer HeapFrom(void *ptr, std::size_t size);
+
+	/**
+	 * @brief Creates a buffer of |size| zero bytes
+	 * @details Uses the manager's zeroAlloc when it has one, so large buffers
+	 *          cost no page faults until they are written.
+	 * @throw Exception if the manager can't allocate
+	 */
+	[[nodiscard]] static Buffer Zeroed(const BufferManager *manager, std::size_t size);
+	[[nodiscard]] static Buffer HeapZeroed(std::size_t size);
+
+	/**
+	 * @brief Copies every span into its own buffer, all carved from one allocation
+	 * @details The buffers are on arenaManager; the allocation is freed when the
+	 *          last of them is released.
+	 * @throw Exception if a span is too large, or the allocation fails
+	 */
+	[[nodiscard]] static std::vector<Buffer> HeapBatch(const std::vector<Span> &spans);
 	[[nodiscard]] static Buffer Stack(void *ptr, std::size_t size);
 	[[nodiscard]] static const Buffer Static(void *ptr, std::size_t size);
 
 	Buffer &operator=(const Buffer &other);
-	Buffer &operator=(Buffer &&other);
+	Buffer &operator=(Buffer &&other) noexcept;
 
 	int compare(const Buffer &other) const noexcept;
+	int compare(const Buffer &other, const Parallel &policy) const;
 
 	operator bool() const;
 	bool operator!() const;
@@ -109,6 +282,10 @@ public:
 	[[nodiscard]] void *data() const noexcept;
 
 	std::size_t size() const noexcept;
+
+	//! @brief True if other buffers or iterators share the data
+	bool shared() const noexcept;
+
 	std::size_t preallocated() const noexcept;
 	std::size_t totalsize() const noexcept;
 	const BufferManager *manager() const noexcept;
@@ -119,7 +296,7 @@ public:
 #ifdef CPPX_BUFFER_DEBUG
 	inline std::uint16_t refcount() const
 	{
-		return m_core ? m_core->m_refcount : 0;
+		return m_core ? static_cast<std::uint16_t>(m_core->m_refcount) : 0;
 	}
 #endif
 
@@ -223,7 +400,33 @@ public:
 
 	Buffer &selfPreallocate(std::size_t extra, const BufferManager *manager = nullptr);
 
+	/**
+	 * @brief Gives the preallocated bytes back to the manager
+	 * @details Shared buffers are left as they are, since the other copies keep the data alive.
+	 * @throw Exception if the smaller copy could not be allocated
+	 */
+	Buffer &selfShrinkToFit();
+
+	/**
+	 * @brief Grows the buffer by |bytes| of its preallocated tail
+	 * @details For data written past the end through data(), e.g. by a read
+	 *          into the tail; the bytes are taken as they are.
+	 * @throw Exception if the tail is shorter, or the buffer is shared or can't be modified
+	 */
+	Buffer &selfCommit(std::size_t bytes);
+
+	//! @brief Sets the automatic trim policy of every buffer; not synchronized, set it at startup
+	static void setTrimPolicy(const TrimPolicy &policy) noexcept;
+	static TrimPolicy trimPolicy() noexcept;
+
+	/**
+	 * @brief Gives the buffer its own copy of the data if it is shared
+	 * @throw Exception if the copy could not be allocated
+	 */
+	Buffer &selfDetach();
+
 	[[nodiscard]] Buffer clone(const BufferManager *manager = nullptr) const;
+	[[nodiscard]] Buffer clone(const Parallel &policy, const BufferManager *manager = nullptr) const;
 	Buffer &selfClone(const Buffer &other, const BufferManager *manager = nullptr);
 
 	[[nodiscard]] Buffer range(std::size_t start, std::size_t end, const BufferManager *manager = nullptr) const;
@@ -232,13 +435,31 @@ public:
 	[[nodiscard]] Buffer reverse(const BufferManager *manager = nullptr) const;
 	[[nodiscard]] Buffer reverse(std::size_t start, std::size_t end, const BufferManager *manager = nullptr) const;
 	[[nodiscard]] Buffer reverse(Iterator start, Iterator end, const BufferManager *manager = nullptr) const;
+	[[nodiscard]] Buffer reverse(const Parallel &policy, const BufferManager *manager = nullptr) const;
 
 	Buffer &selfReverse();
 	Buffer &selfReverse(std::size_t start, std::size_t end);
 	Buffer &selfReverse(Iterator start, Iterator end);
 
+	/**
+	 * @brief Sets every byte of the range to |value|
+	 * @throw Exception if the range is invalid, or the buffer can't be modified
+	 */
+	Buffer &selfFill(byte_t value);
+	Buffer &selfFill(std::size_t start, std::size_t end, byte_t value);
+	Buffer &selfFill(Iterator start, Iterator end, byte_t value);
+
+	/**
+	 * @brief Repeats |pattern| over the range, starting with its first byte; the last copy may be cut short
+	 * @throw Exception if the range is invalid, the buffer can't be modified, or the pattern is empty
+	 */
+	Buffer &selfFill(const Buffer &pattern);
+	Buffer &selfFill(std::size_t start, std::size_t end, const Buffer &pattern);
+	Buffer &selfFill(Iterator start, Iterator end, const Buffer &pattern);
+
 	[[nodiscard]] Buffer insert(std::size_t index, const Buffer &value, const BufferManager *manager = nullptr) const;
 	[[nodiscard]] Buffer insert(Iterator index, const Buffer &value, const BufferManager *manager = nullptr) const;
+	[[nodiscard]] Buffer insert(std::size_t index, const Buffer &value, const Parallel &policy, const BufferManager *manager = nullptr) const;
 	[[nodiscard]] Buffer append(const Buffer &right, const BufferManager *manager = nullptr) const;
 
 	Buffer &selfInsert(std::size_t index, const Buffer &value);
@@ -248,6 +469,13 @@ public:
 	[[nodiscard]] Buffer erase(std::size_t start, std::size_t end, const BufferManager *manager = nullptr) const;
 	[[nodiscard]] Buffer erase(Iterator start, Iterator end, const BufferManager *manager = nullptr) const;
 
+	/**
+	 * @brief Removes the bytes from |start| to |end|
+	 * @details The erased bytes become preallocated space when they fit in it.
+	 *          A longer tail is cut with the manager's reallocate when it has
+	 *          one; otherwise the remaining bytes are copied to a new allocation.
+	 * @throw Exception if the range is invalid, or the buffer can't be modified
+	 */
 	Buffer &selfErase(std::size_t start, std::size_t end);
 	Buffer &selfErase(Iterator start, Iterator end);
 
@@ -258,6 +486,7 @@ public:
 		PREFIXED = 0x08
 	};
 	std::string represent(std::uint8_t form = Representation::HEX) const;
+	std::string represent(std::uint8_t form, const Parallel &policy) const;
 	inline std::string toString() const { return represent(Representation::HEX | Representation::PREFIXED); }
 };
 } // namespace cppx
@@ -0,0 +1,95 @@
+#ifndef CPPX_CACHE_H
+#define CPPX_CACHE_H
+
+#include "cppxBuffer.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+namespace cppx {
+
+/** @brief Snapshot of the counters of a BufferCache */
+struct CacheStats {
+	std::uint64_t hits;
+	std::uint64_t misses;
+	std::uint64_t insertions;
+	std::uint64_t evictions;
+
+	std::uint64_t entries;
+	std::uint64_t bytes;
+
+	//! @brief hits / (hits + misses), or 0 before the first lookup
+	double hitRatio() const noexcept;
+
+	std::string toString() const;
+};
+
+/**
+ * @brief Least-recently-used cache of buffers, bounded by bytes
+ * @details Keys are matched by contents and copied into the cache; values are
+ *          stored and returned as shared buffers, so neither put() nor get()
+ *          copies a payload. An entry costs the totalsize() of its key and
+ *          value, taken when it is put, and may take the whole budget.
+ *          Entries are spread over shards with a lock each, and the budget
+ *          applies to their bytes together: a put that goes over it evicts
+ *          the least recently used entries of its own shard, then those of the
+ *          others. LRU order is kept per shard. A value shared with the
+ *          cache must not be modified in place; use a copy-on-write manager
+ *          or clone it first. Sharing values between threads needs a build
+ *          with CPPX_BUFFER_ATOMIC.
+ */
+class BufferCache {
+public:
+	constexpr static const std::size_t default_shards = 16;
+
+private:
+	struct Shard;
+
+	std::unique_ptr<Shard[]> m_shards;
+	std::size_t m_shardCount;
+	std::size_t m_budget;
+	std::atomic<std::size_t> m_bytes{0};
+
+	Shard &shardOf(std::uint64_t hash) const noexcept;
+
+public:
+	/**
+	 * @brief Creates a cache holding up to |budget| bytes
+	 * @throw Exception if |shards| is 0
+	 */
+	explicit BufferCache(std::size_t budget, std::size_t shards = default_shards);
+	~BufferCache();
+
+	BufferCache(const BufferCache &) = delete;
+	BufferCache &operator=(const BufferCache &) = delete;
+
+	/**
+	 * @brief Sets |value| to the cached value of |key| and marks it as recently used
+	 * @return false on a miss, leaving |value| unchanged
+	 */
+	bool get(const Buffer &key, Buffer &value);
+
+	/**
+	 * @brief Caches |value| under |key|, replacing any earlier value
+	 * @return false if the entry is larger than the budget, and isn't cached
+	 * @throw Exception if the key can't be copied
+	 */
+	bool put(const Buffer &key, const Buffer &value);
+
+	//! @brief Returns false if |key| wasn't cached
+	bool erase(const Buffer &key);
+
+	void clear();
+
+	std::size_t budget() const noexcept;
+
+	CacheStats stats() const;
+	void resetStats();
+};
+
+} // namespace cppx
+
+#endif // !defined(CPPX_CACHE_H)
@@ -0,0 +1,64 @@
+#ifndef CPPX_CHECKSUM_H
+#define CPPX_CHECKSUM_H
+
+#include "cppxBuffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace cppx {
+
+/**
+ * @brief Computes the CRC-32C (Castagnoli) checksum of the data
+ * @details Passing a previous result as |crc| continues the checksum over the next piece of data.
+ */
+std::uint32_t crc32c(const void *data, std::size_t size, std::uint32_t crc = 0) noexcept;
+std::uint32_t crc32c(const Buffer &buffer, std::uint32_t crc = 0) noexcept;
+
+/**
+ * @brief Computes the CRC-32C checksum of the bytes in [start, end) of the buffer
+ * @throw Exception if the range is invalid
+ */
+std::uint32_t crc32c(const Buffer &buffer, std::size_t start, std::size_t end, std::uint32_t crc = 0);
+std::uint32_t crc32c(const std::vector<Buffer> &chain, std::uint32_t crc = 0) noexcept;
+
+/**
+ * @brief Returns the CRC-32C of the concatenation A + B
+ * @param crcA checksum of A
+ * @param crcB checksum of B
+ * @param sizeB length of B in bytes
+ */
+std::uint32_t crc32cCombine(std::uint32_t crcA, std::uint32_t crcB, std::size_t sizeB) noexcept;
+
+//! @brief Returns true if crc32c uses the SSE4.2 crc32 instruction on this machine
+bool crc32cAccelerated() noexcept;
+
+//! @brief crc32c with the slicing-by-8 tables, whatever the machine supports
+std::uint32_t crc32cPortable(const void *data, std::size_t size, std::uint32_t crc = 0) noexcept;
+
+/**
+ * @brief Computes the Adler-32 checksum of the data
+ * @details Passing a previous result as |adler| continues the checksum over the next piece of data.
+ */
+std::uint32_t adler32(const void *data, std::size_t size, std::uint32_t adler = 1) noexcept;
+std::uint32_t adler32(const Buffer &buffer, std::uint32_t adler = 1) noexcept;
+
+/**
+ * @brief Computes the Adler-32 checksum of the bytes in [start, end) of the buffer
+ * @throw Exception if the range is invalid
+ */
+std::uint32_t adler32(const Buffer &buffer, std::size_t start, std::size_t end, std::uint32_t adler = 1);
+std::uint32_t adler32(const std::vector<Buffer> &chain, std::uint32_t adler = 1) noexcept;
+
+/**
+ * @brief Returns the Adler-32 of the concatenation A + B
+ * @param adlerA checksum of A
+ * @param adlerB checksum of B
+ * @param sizeB length of B in bytes
+ */
+std::uint32_t adler32Combine(std::uint32_t adlerA, std::uint32_t adlerB, std::size_t sizeB) noexcept;
+
+} // namespace cppx
+
+#endif // !defined(CPPX_CHECKSUM_H)
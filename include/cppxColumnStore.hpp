@@ -0,0 +1,119 @@
+#ifndef CPPX_COLUMNSTORE_H
+#define CPPX_COLUMNSTORE_H
+
+#include "cppxBuffer.hpp"
+#include "cppxException.hpp"
+#include "cppxTypedView.hpp"
+
+#include <cstddef>
+#include <vector>
+
+namespace cppx {
+
+/**
+ * @brief Fixed-layout records stored as one contiguous buffer per field
+ * @details Column i holds field i of every row back to back, widths[i] bytes
+ *          each, so a scan over one field reads only that field's memory. A
+ *          record in row-major form is the fields in column order with no
+ *          padding. Columns grow together, doubling their capacity, and their
+ *          data moves when they do: windows and views taken from the store are
+ *          valid until the next append or reserve. Copies of a store share
+ *          its columns until one of them writes to them, which gives it its
+ *          own copy first.
+ */
+class ColumnStore {
+private:
+	std::vector<std::size_t> m_widths;
+	std::vector<Buffer> m_columns;
+	std::size_t m_rowSize;
+	std::size_t m_rows;
+	std::size_t m_capacity;
+	const BufferManager *m_manager;
+
+	//! @brief Makes room for |rows| rows in every column
+	void grow(std::size_t rows);
+
+	//! @brief Gives the store its own copy of every column still shared with a copy of it
+	void detach();
+
+	void checkView(const char *function, std::size_t index, std::size_t size) const;
+
+public:
+	/**
+	 * @brief Creates an empty store with a column of every width, allocated on |manager|
+	 * @throw Exception if there are no columns, a width is 0, or the manager can't allocate
+	 */
+	explicit ColumnStore(const std::vector<std::size_t> &widths, const BufferManager *manager = Buffer::onHeap);
+
+	std::size_t columns() const noexcept;
+	std::size_t rows() const noexcept;
+	std::size_t capacity() const noexcept;
+
+	//! @brief Bytes in a row-major record; the sum of the widths
+	std::size_t rowSize() const noexcept;
+
+	/**
+	 * @throw Exception if there is no such column
+	 */
+	std::size_t width(std::size_t index) const;
+
+	/**
+	 * @brief The bytes of the column's rows, as a non-owning buffer
+	 * @details The non-const overload detaches the column from copies of the store first.
+	 * @throw Exception if there is no such column, or the column can't be detached
+	 */
+	Buffer column(std::size_t index);
+	const Buffer column(std::size_t index) const;
+
+	/**
+	 * @brief The column's rows as |T|
+	 * @throw Exception if there is no such column, or sizeof(T) is not its width
+	 */
+	template <typename T>
+	TypedView<T> view(std::size_t index)
+	{
+		checkView(__FUNCTION__, index, sizeof(T));
+
+		auto window = column(index);
+		return TypedView<T>(window);
+	}
+
+	template <typename T>
+	TypedView<const T> view(std::size_t index) const
+	{
+		checkView(__FUNCTION__, index, sizeof(T));
+
+		return TypedView<const T>(column(index));
+	}
+
+	/**
+	 * @brief Copies row |index| into a row-major record, on |manager| or the store's manager
+	 * @throw Exception if there is no such row, or the manager can't allocate
+	 */
+	[[nodiscard]] Buffer row(std::size_t index, const BufferManager *manager = nullptr) const;
+
+	/**
+	 * @throw Exception if the columns can't hold |rows| rows, or the allocation fails
+	 */
+	ColumnStore &selfReserve(std::size_t rows);
+
+	/**
+	 * @brief Appends |count| row-major records, packed back to back at |records|
+	 * @throw Exception if the columns can't grow
+	 */
+	ColumnStore &selfAppendRows(const void *records, std::size_t count);
+
+	/**
+	 * @brief Appends the rows held by one buffer per column
+	 * @details Every buffer holds the same number of fields of its column's width.
+	 * @throw Exception if the buffers don't match the columns, or the columns can't grow
+	 */
+	ColumnStore &selfAppendColumns(const std::vector<Buffer> &batch);
+
+	//! @brief Drops every row, keeping the capacity
+	ColumnStore &selfClear() noexcept;
+};
+
+} // namespace cppx
+
+#endif // !defined(CPPX_COLUMNSTORE_H)
@@ -0,0 +1,81 @@
+#ifndef CPPX_COMPRESS_H
+#define CPPX_COMPRESS_H
+
+#include "cppxBuffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cppx {
+
+/**
+ * @brief Built-in LZ77-family codec
+ * @details Data is split into blocks of at most block_size bytes. Every block
+ *          starts with an 8-byte header (little-endian payload size, with the
+ *          top bit set for blocks stored uncompressed, then the original size),
+ *          so streams can be concatenated and decoded incrementally.
+ */
+class Compression {
+public:
+	constexpr static const std::size_t block_size = BufferCore::max_preall;
+	constexpr static const std::size_t header_size = 8;
+
+public:
+	//! @brief Upper bound of the compressed size of |size| bytes
+	static std::size_t bound(std::size_t size) noexcept;
+
+	/**
+	 * @brief Compresses the whole buffer in one output allocation
+	 * @throw Exception if the manager can't allocate, or the result would be too large
+	 */
+	[[nodiscard]] static Buffer compress(const Buffer &source, const BufferManager *manager = nullptr);
+
+	/**
+	 * @brief Decompresses every block in the buffer into one output allocation
+	 * @throw Exception if the manager can't allocate, or the data is corrupted
+	 */
+	[[nodiscard]] static Buffer decompress(const Buffer &source, const BufferManager *manager = nullptr);
+};
+
+/** @brief Compresses input given in chunks of any size */
+class CompressStream {
+private:
+	const BufferManager *m_manager;
+	Buffer m_pending;
+
+public:
+	explicit CompressStream(const BufferManager *manager = Buffer::onHeap);
+
+	/**
+	 * @brief Feeds a chunk of input
+	 * @returns the blocks completed by this chunk; may be empty
+	 */
+	[[nodiscard]] Buffer write(const Buffer &chunk);
+
+	//! @brief Returns the block holding the remaining buffered input; may be empty
+	[[nodiscard]] Buffer flush();
+};
+
+/** @brief Decompresses a block stream given in chunks of any size */
+class DecompressStream {
+private:
+	const BufferManager *m_manager;
+	Buffer m_pending;
+
+public:
+	explicit DecompressStream(const BufferManager *manager = Buffer::onHeap);
+
+	/**
+	 * @brief Feeds a chunk of compressed input
+	 * @returns the data of the blocks completed by this chunk; may be empty
+	 * @throw Exception if the data is corrupted
+	 */
+	[[nodiscard]] Buffer write(const Buffer &chunk);
+
+	//! @brief Returns true if a partial block is still waiting for input
+	bool pending() const noexcept;
+};
+
+} // namespace cppx
+
+#endif // !defined(CPPX_COMPRESS_H)
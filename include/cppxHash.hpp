@@ -0,0 +1,56 @@
+#ifndef CPPX_HASH_H
+#define CPPX_HASH_H
+
+#include "cppxBuffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+namespace cppx {
+
+/**
+ * @brief Incremental, non-cryptographic 64-bit hasher (XXH64)
+ * @details Feeding the same bytes in any number of update() calls yields the
+ *          same digest as hashing them in one shot, so chained or streamed
+ *          buffers can be hashed without concatenating them first.
+ */
+class Hasher {
+public:
+	constexpr static const std::size_t stripe_size = 32;
+
+private:
+	std::uint64_t m_lanes[4];
+	std::uint64_t m_seed;
+	std::uint64_t m_total;
+	std::uint8_t m_pending[stripe_size];
+	std::uint32_t m_pendingSize;
+
+public:
+	explicit Hasher(std::uint64_t seed = 0) noexcept;
+
+	Hasher &reset(std::uint64_t seed = 0) noexcept;
+
+	Hasher &update(const void *data, std::size_t size) noexcept;
+	Hasher &update(const Buffer &buffer) noexcept;
+
+	//! @brief Returns the hash of every byte fed so far; the hasher can still be updated afterwards
+	std::uint64_t digest() const noexcept;
+
+	static std::uint64_t hash(const void *data, std::size_t size, std::uint64_t seed = 0) noexcept;
+	static std::uint64_t hash(const Buffer &buffer, std::uint64_t seed = 0) noexcept;
+};
+
+} // namespace cppx
+
+namespace std {
+template <>
+struct hash<cppx::Buffer> {
+	inline std::size_t operator()(const cppx::Buffer &buffer) const noexcept
+	{
+		return static_cast<std::size_t>(cppx::Hasher::hash(buffer));
+	}
+};
+} // namespace std
+
+#endif // !defined(CPPX_HASH_H)
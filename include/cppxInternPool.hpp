@@ -0,0 +1,75 @@
+#ifndef CPPX_INTERNPOOL_H
+#define CPPX_INTERNPOOL_H
+
+#include "cppxBuffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace cppx {
+
+/**
+ * @brief Deduplicates buffers by content
+ * @details intern() returns the pool's buffer for the given contents, so equal
+ *          payloads share one allocation and compare equal by data() pointer.
+ *          The pool keeps one reference to every entry. Entries that nothing
+ *          else refers to any more are evicted by sweep(), which intern() also
+ *          runs on a shard each time the shard has doubled since its last sweep.
+ *          Entries are spread over shards with a lock each, so lookups from
+ *          different threads rarely wait for each other. The default manager is
+ *          copy-on-write, so modifying a returned buffer through its methods
+ *          detaches it instead of changing the pooled contents; writes through
+ *          data() are not tracked and must not be made. Returned buffers
+ *          share the pooled reference count, so handing them to several
+ *          threads needs a build with CPPX_BUFFER_ATOMIC.
+ */
+class InternPool {
+public:
+	constexpr static const std::size_t default_shards = 16;
+
+private:
+	struct Shard;
+
+	std::unique_ptr<Shard[]> m_shards;
+	std::size_t m_shardCount;
+	const BufferManager *m_manager;
+
+	Shard &shardOf(std::uint64_t hash) const noexcept;
+
+public:
+	/**
+	 * @brief Creates a pool whose entries are copies on |manager|
+	 * @throw Exception if |shards| is 0, or the manager can't allocate
+	 */
+	explicit InternPool(std::size_t shards = default_shards, const BufferManager *manager = Buffer::onHeapCow);
+	~InternPool();
+
+	InternPool(const InternPool &) = delete;
+	InternPool &operator=(const InternPool &) = delete;
+
+	/**
+	 * @brief Returns the pooled buffer with the contents of |buffer|, adding a copy if there is none
+	 * @details Empty buffers are not pooled; an empty buffer is returned for them.
+	 * @throw Exception if the copy can't be allocated
+	 */
+	[[nodiscard]] Buffer intern(const Buffer &buffer);
+
+	bool contains(const Buffer &buffer) const;
+
+	//! @brief Number of pooled buffers
+	std::size_t size() const;
+
+	//! @brief Bytes held by the pooled buffers
+	std::size_t bytes() const;
+
+	//! @brief Evicts the entries no buffer outside the pool refers to; returns how many
+	std::size_t sweep();
+
+	//! @brief Drops every entry; buffers already handed out stay valid
+	void clear();
+};
+
+} // namespace cppx
+
+#endif // !defined(CPPX_INTERNPOOL_H)
@@ -0,0 +1,69 @@
+#ifndef CPPX_MANAGERS_H
+#define CPPX_MANAGERS_H
+
+#include "cppxBuffer.hpp"
+
+#include <cstddef>
+
+namespace cppx {
+
+/**
+ * @brief Additional heap managers with control over alignment, page size and placement
+ * @details For the huge page managers, blocks of at least huge_page_size bytes
+ *          are mapped with mmap and advised for transparent huge pages; smaller
+ *          ones come from malloc like on Buffer::heapManager. On other systems
+ *          than Linux every block comes from malloc.
+ */
+class Managers {
+public:
+	constexpr static const std::size_t huge_page_size = std::size_t(2) << 20;
+	constexpr static const std::size_t page_size = 4096;
+
+	//! @brief data() of their buffers is aligned to the number of bytes in the name, also after growing
+	static const BufferManager aligned16Manager;
+	static const BufferManager aligned32Manager;
+	static const BufferManager aligned64Manager;
+	static const BufferManager aligned4096Manager;
+
+	/**
+	 * @brief Page-aligned blocks whose length is rounded up to whole pages
+	 * @details Reads and writes with O_DIRECT may cover the rounded length of a
+	 *          buffer, up to totalsize() rounded up to page_size.
+	 */
+	static const BufferManager directManager;
+
+	static constexpr const BufferManager *onAligned16 = &aligned16Manager;
+	static constexpr const BufferManager *onAligned32 = &aligned32Manager;
+	static constexpr const BufferManager *onAligned64 = &aligned64Manager;
+	static constexpr const BufferManager *onAligned4096 = &aligned4096Manager;
+	static constexpr const BufferManager *onDirect = &directManager;
+
+	static const BufferManager hugePageManager;
+
+	//! @brief Like hugePageManager, with the large blocks interleaved page by page across every NUMA node
+	static const BufferManager interleavedManager;
+
+	static constexpr const BufferManager *onHugePages = &hugePageManager;
+	static constexpr const BufferManager *onInterleaved = &interleavedManager;
+
+public:
+	/**
+	 * @brief Returns the aligned manager for |alignment|
+	 * @throw Exception if |alignment| is not one of 16, 32, 64 or 4096
+	 */
+	static const BufferManager *aligned(std::size_t alignment);
+
+	//! @brief Number of NUMA nodes of the system; 1 if it can't be determined
+	static std::size_t numaNodes() noexcept;
+
+	/**
+	 * @brief Returns a manager like hugePageManager whose large blocks are bound to |node|
+	 * @details If the system has a single node, or |node| does not exist, the
+	 *          blocks are placed like on hugePageManager.
+	 */
+	[[nodiscard]] static BufferManager nodeManager(std::size_t node);
+};
+
+} // namespace cppx
+
+#endif // !defined(CPPX_MANAGERS_H)
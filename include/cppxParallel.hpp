@@ -0,0 +1,38 @@
+#ifndef CPPX_PARALLEL_H
+#define CPPX_PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+namespace cppx {
+
+/**
+ * @brief Execution policy for the parallel overloads of Buffer operations
+ * @details Work is split into |chunk|-byte pieces which the threads take in
+ *          turn; inputs no larger than one chunk run on the calling thread.
+ */
+struct Parallel {
+	constexpr static const std::size_t default_chunk = std::size_t(1) << 20;
+
+	//! @brief Threads to use, including the calling thread; 0 uses every hardware thread
+	std::size_t threads = 0;
+
+	//! @brief Bytes handed to a thread at a time
+	std::size_t chunk = default_chunk;
+
+	std::size_t concurrency() const noexcept;
+
+	/**
+	 * @brief Calls |task| with consecutive [begin, end) pieces of [0, size) from up to concurrency() threads
+	 * @details Returns once every piece is done. Pieces run on the calling
+	 *          thread when no more threads can be started. An exception thrown
+	 *          by |task| on the calling thread stops the other threads after
+	 *          their current piece, and is rethrown once they are joined; one
+	 *          thrown on another thread terminates the process.
+	 */
+	void forEachChunk(std::size_t size, const std::function<void(std::size_t, std::size_t)> &task) const;
+};
+
+} // namespace cppx
+
+#endif // !defined(CPPX_PARALLEL_H)
@@ -0,0 +1,75 @@
+#ifndef CPPX_POOL_H
+#define CPPX_POOL_H
+
+#include "cppxBuffer.hpp"
+
+#include <cstddef>
+#include <memory>
+
+namespace cppx {
+
+struct PoolOptions {
+	//! @brief Blocks a thread keeps for itself; when it has more, half of them go to the overflow list
+	std::size_t threadCache = 64;
+
+	//! @brief Blocks the overflow list keeps for any thread; blocks beyond it are freed
+	std::size_t overflow = 1024;
+};
+
+/**
+ * @brief Recycles the blocks of equally sized preallocated buffers
+ * @details The pool has a manager of its own, on which every block of
+ *          exactly blockSize() bytes is recycled instead of freed: releasing
+ *          it pushes it onto a free list of the releasing thread, and the
+ *          next allocation of that size on the thread pops it again. A thread
+ *          whose list grows past PoolOptions::threadCache moves half of it to
+ *          an overflow list shared by all threads, which threads with an
+ *          empty list refill from; blocks of exiting threads go there too.
+ *          Blocks of other sizes, such as those of buffers grown past the
+ *          block size, come from and go back to the heap. The cores of the
+ *          pool's buffers are recycled on a list per thread as well. The pool
+ *          must outlive the buffers on its manager.
+ */
+class BufferPool {
+public:
+	struct Shared;
+
+private:
+	std::shared_ptr<Shared> m_shared;
+	BufferManager m_manager;
+
+public:
+	/**
+	 * @brief Creates a pool of blocks of |blockSize| bytes
+	 * @throw Exception if |blockSize| is 0 or larger than BufferCore::max_preall, or |options| keep no blocks per thread
+	 */
+	explicit BufferPool(std::size_t blockSize, const PoolOptions &options = PoolOptions());
+
+	//! @brief Frees the overflow list and the calling thread's list; other threads free theirs when they exit or next miss a pool
+	~BufferPool();
+
+	BufferPool(const BufferPool &) = delete;
+	BufferPool &operator=(const BufferPool &) = delete;
+
+	const BufferManager *manager() const noexcept;
+	std::size_t blockSize() const noexcept;
+
+	/**
+	 * @brief Returns an empty buffer with blockSize() bytes preallocated, like Buffer::HeapPreall
+	 * @throw Exception if a new block is needed and can't be allocated
+	 */
+	[[nodiscard]] Buffer acquire();
+
+	//! @brief Blocks taken from the heap so far, not counting those of other sizes
+	std::size_t allocations() const noexcept;
+
+	//! @brief Blocks on the overflow list; only a snapshot while other threads use the pool
+	std::size_t overflowSize() const;
+
+	//! @brief Frees the overflow list and the calling thread's list; the result is the number of blocks freed
+	std::size_t trim();
+};
+
+} // namespace cppx
+
+#endif // !defined(CPPX_POOL_H)
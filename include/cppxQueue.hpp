@@ -0,0 +1,104 @@
+#ifndef CPPX_QUEUE_H
+#define CPPX_QUEUE_H
+
+#include "cppxBuffer.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+namespace cppx {
+
+/**
+ * @brief Bounded lock-free queue of buffers for any number of producers and consumers
+ * @details A ring of slots, each with a sequence number telling whether it
+ *          is free for the producer or filled for the consumer of the current
+ *          lap (Vyukov's bounded MPMC queue). Buffers are moved in and out, so
+ *          a hand-off passes the data along without copying it or touching its
+ *          reference count. The capacity is rounded up to a power of two, and
+ *          is at least 2.
+ */
+class BufferQueue {
+public:
+	constexpr static const std::size_t cache_line = 64;
+
+private:
+	struct Slot;
+
+	std::unique_ptr<Slot[]> m_slots;
+	std::size_t m_mask;
+
+	alignas(cache_line) std::atomic<std::size_t> m_pushAt;
+	alignas(cache_line) std::atomic<std::size_t> m_popAt;
+
+public:
+	//! @throw Exception if |capacity| is 0
+	explicit BufferQueue(std::size_t capacity);
+	~BufferQueue();
+
+	BufferQueue(const BufferQueue &) = delete;
+	BufferQueue &operator=(const BufferQueue &) = delete;
+
+	std::size_t capacity() const noexcept;
+
+	//! @brief Number of queued buffers; only a snapshot while other threads use the queue
+	std::size_t size() const noexcept;
+
+	//! @brief Moves |value| into the queue; false if it is full, leaving |value| as it was
+	bool tryPush(Buffer &&value) noexcept;
+
+	//! @brief Moves the oldest buffer into |value|; false if the queue is empty
+	bool tryPop(Buffer &value) noexcept;
+
+	//! @brief tryPush, yielding the thread while the queue is full
+	void push(Buffer &&value) noexcept;
+
+	//! @brief tryPop, yielding the thread while the queue is empty
+	[[nodiscard]] Buffer pop() noexcept;
+};
+
+/**
+ * @brief Bounded lock-free queue of buffers for one producer and one consumer
+ * @details Each side owns one index and keeps a cached copy of the other's,
+ *          so it reads the shared one only when the cache says the queue is
+ *          full or empty. Using it from more than one producer or consumer
+ *          thread at a time is undefined. The capacity is rounded up to a
+ *          power of two, and is at least 2.
+ */
+class SpscBufferQueue {
+public:
+	constexpr static const std::size_t cache_line = BufferQueue::cache_line;
+
+private:
+	std::unique_ptr<Buffer[]> m_slots;
+	std::size_t m_mask;
+
+	// the producer's line
+	alignas(cache_line) std::atomic<std::size_t> m_tail;
+	std::size_t m_headCache;
+
+	// the consumer's line
+	alignas(cache_line) std::atomic<std::size_t> m_head;
+	std::size_t m_tailCache;
+
+public:
+	//! @throw Exception if |capacity| is 0
+	explicit SpscBufferQueue(std::size_t capacity);
+	~SpscBufferQueue();
+
+	SpscBufferQueue(const SpscBufferQueue &) = delete;
+	SpscBufferQueue &operator=(const SpscBufferQueue &) = delete;
+
+	std::size_t capacity() const noexcept;
+	std::size_t size() const noexcept;
+
+	bool tryPush(Buffer &&value) noexcept;
+	bool tryPop(Buffer &value) noexcept;
+
+	void push(Buffer &&value) noexcept;
+	[[nodiscard]] Buffer pop() noexcept;
+};
+
+} // namespace cppx
+
+#endif // !defined(CPPX_QUEUE_H)
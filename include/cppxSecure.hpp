@@ -0,0 +1,60 @@
+#ifndef CPPX_SECURE_H
+#define CPPX_SECURE_H
+
+#include "cppxBuffer.hpp"
+
+#include <cstddef>
+
+namespace cppx {
+
+/**
+ * @brief Storage and helpers for secrets such as keys and tokens
+ * @details Buffers on secureManager live in locked memory that is excluded from
+ *          core dumps and surrounded by guard pages. Blocks up to
+ *          max_pooled_size bytes are slots of pooled regions, so a buffer costs
+ *          no system call once its size class has a free slot; larger blocks
+ *          get a mapping of their own. Every block is zeroed when released,
+ *          including the old blocks left behind by growing buffers. On other
+ *          systems than Linux blocks come from malloc, and are still zeroed.
+ */
+class Secure {
+public:
+	constexpr static const std::size_t max_pooled_size = 4096;
+
+	static const BufferManager secureManager;
+
+	static constexpr const BufferManager *onSecure = &secureManager;
+
+public:
+	//! @brief Zeroes |size| bytes at |data| in a way the compiler can't leave out
+	static void wipe(void *data, std::size_t size) noexcept;
+
+	/**
+	 * @brief Zeroes the whole storage of the buffer, including the preallocated bytes
+	 * @details The data is not detached first, so every buffer sharing it sees
+	 *          it zeroed; a private copy would leave the secret behind. Buffers
+	 *          whose manager doesn't allow modification are left as they are.
+	 */
+	static void wipe(Buffer &buffer) noexcept;
+
+	/**
+	 * @brief Compares |size| bytes in time independent of their contents
+	 * @details Every byte is read and no branch depends on the data, so the
+	 *          time taken reveals nothing about where the inputs differ.
+	 */
+	static bool equal(const void *left, const void *right, std::size_t size) noexcept;
+
+	/**
+	 * @brief Compares the contents of two buffers in constant time
+	 * @details Sizes are treated as public: buffers of different sizes compare
+	 *          unequal right away. Use it for MACs and tokens, not compare().
+	 */
+	static bool equal(const Buffer &left, const Buffer &right) noexcept;
+
+	//! @brief Returns false if locking any of the memory failed, e.g. because of RLIMIT_MEMLOCK
+	static bool locked() noexcept;
+};
+
+} // namespace cppx
+
+#endif // !defined(CPPX_SECURE_H)
@@ -0,0 +1,98 @@
+#ifndef CPPX_TRACE_H
+#define CPPX_TRACE_H
+
+#include "cppxBuffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+#include <vector>
+
+namespace cppx {
+
+/** @brief One buffer lifetime event */
+struct TraceEvent {
+	enum Type : std::uint8_t {
+		CREATE,
+		ALLOCATE,
+		GROW,
+		DETACH,
+		RELEASE
+	};
+
+	Type type;
+
+	//! @brief Nanoseconds since the first event of the process
+	std::uint64_t timestamp;
+
+	//! @brief Bytes involved; the new total size for GROW
+	std::uint64_t size;
+
+	const BufferManager *manager;
+
+	//! @brief Tag of the innermost BufferTrace::Scope of the thread; may be nullptr
+	const char *tag;
+
+	//! @brief Small sequential number of the emitting thread
+	std::uint32_t thread;
+
+	static const char *typeName(Type type) noexcept;
+};
+
+/**
+ * @brief Records buffer lifetime events
+ * @details Buffers emit events only when the library is built with
+ *          CPPX_BUFFER_TRACE. Events go into a lock-free ring that keeps the
+ *          last ring_size of them, and to the callback if one is installed.
+ *          An event whose slot is still being written by a thread a whole
+ *          ring behind is left out of the ring.
+ */
+class BufferTrace {
+public:
+	constexpr static const std::size_t ring_size = std::size_t(1) << 16;
+
+	using Callback = std::function<void(const TraceEvent &)>;
+
+	/**
+	 * @brief Tags the events emitted by the current thread while in scope
+	 * @details |tag| must outlive the scope; string literals are the intended use.
+	 */
+	class Scope {
+	private:
+		const char *m_previous;
+
+	public:
+		explicit Scope(const char *tag) noexcept;
+		~Scope();
+
+		Scope(const Scope &) = delete;
+		Scope &operator=(const Scope &) = delete;
+	};
+
+public:
+	static void record(TraceEvent::Type type, std::size_t size, const BufferManager *manager) noexcept;
+
+	static void setEnabled(bool enabled) noexcept;
+	static bool enabled() noexcept;
+
+	/**
+	 * @brief Calls |callback| for every event, from the emitting thread
+	 * @details Not synchronized with the events themselves; install or remove
+	 *          the callback while no buffers are being traced. An empty
+	 *          callback removes it.
+	 */
+	static void setCallback(Callback callback);
+
+	//! @brief Returns the events still in the ring, oldest first
+	static std::vector<TraceEvent> events();
+	static void clear() noexcept;
+
+	//! @brief Writes |events| as Chrome trace JSON (chrome://tracing, Perfetto)
+	static void exportChrome(std::ostream &stream, const std::vector<TraceEvent> &events);
+	static void exportChrome(std::ostream &stream);
+};
+
+} // namespace cppx
+
+#endif // !defined(CPPX_TRACE_H)
@@ -0,0 +1,285 @@
+#ifndef CPPX_TYPEDVIEW_H
+#define CPPX_TYPEDVIEW_H
+
+#include "cppxBuffer.hpp"
+#include "cppxException.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+namespace cppx {
+
+/**
+ * @brief Array of |T| over the data of a buffer
+ * @details Size and alignment are checked once, when the view is made; element
+ *          access is unchecked, so loops over the view compile like loops over
+ *          a plain array. The view doesn't own the data: it is valid until the
+ *          buffer is resized, detached or destroyed. Views of non-const |T|
+ *          detach a shared buffer first, since writes through them aren't
+ *          tracked. Use a view of const |T| for read-only buffers.
+ */
+template <typename T>
+class TypedView {
+	static_assert(std::is_trivially_copyable_v<T>, "TypedView needs a trivially copyable type");
+
+public:
+	using value_type = std::remove_const_t<T>;
+	using size_type = std::size_t;
+	using pointer = T *;
+	using reference = T &;
+	using iterator = T *;
+
+private:
+	constexpr static const char *size_mismatch = "Buffer size is not a multiple of the element size";
+	constexpr static const char *misaligned = "Buffer data is not aligned for the element type";
+	constexpr static const char *buf_readonly = "Buffer cannot be modified";
+	constexpr static const char *index_invalid = "Invalid index";
+
+	T *m_data;
+	std::size_t m_count;
+
+	void check(const char *function, const Buffer &buffer)
+	{
+		if (buffer.size() % sizeof(T))
+			throw Exception(Exception::makeCallString(function, buffer), size_mismatch);
+
+		if (reinterpret_cast<std::uintptr_t>(buffer.data()) % alignof(T))
+			throw Exception(Exception::makeCallString(function, buffer), misaligned);
+
+		m_data = static_cast<T *>(buffer.data());
+		m_count = buffer.size() / sizeof(T);
+	}
+
+public:
+	constexpr TypedView() noexcept : m_data(nullptr), m_count(0) {}
+
+	/**
+	 * @throw Exception if the size or alignment doesn't fit |T|, or a view of non-const |T| is made of a read-only buffer
+	 */
+	explicit TypedView(Buffer &buffer)
+	{
+		if constexpr (!std::is_const_v<T>) {
+			if (buffer.manager() && !buffer.manager()->flags.modify)
+				throw Exception(Exception::makeCallString(__FUNCTION__, buffer), buf_readonly);
+
+			if (buffer.manager())
+				buffer.selfDetach();
+		}
+
+		check(__FUNCTION__, buffer);
+	}
+
+	/**
+	 * @throw Exception if the size or alignment doesn't fit |T|
+	 */
+	template <typename U = T, typename = std::enable_if_t<std::is_const_v<U>>>
+	explicit TypedView(const Buffer &buffer)
+	{
+		check(__FUNCTION__, buffer);
+	}
+
+	//! @brief True if |buffer| can be viewed as |T| without the unaligned variant
+	static bool fits(const Buffer &buffer) noexcept
+	{
+		return !(buffer.size() % sizeof(T)) && !(reinterpret_cast<std::uintptr_t>(buffer.data()) % alignof(T));
+	}
+
+	constexpr T *data() const noexcept { return m_data; }
+	constexpr std::size_t size() const noexcept { return m_count; }
+	constexpr bool empty() const noexcept { return !m_count; }
+
+	constexpr T *begin() const noexcept { return m_data; }
+	constexpr T *end() const noexcept { return m_data + m_count; }
+
+	constexpr T &operator[](std::size_t i) const noexcept { return m_data[i]; }
+
+	/**
+	 * @throw Exception if |i| is beyond the end of the view
+	 */
+	T &at(std::size_t i) const
+	{
+		if (i >= m_count)
+			throw Exception(Exception::makeCallString(__FUNCTION__, i), index_invalid);
+
+		return m_data[i];
+	}
+};
+
+/**
+ * @brief Array of |T| over buffer data of any alignment
+ * @details Elements are copied in and out with memcpy, which compiles to plain
+ *          unaligned loads and stores, so packed records and offsets into a
+ *          buffer are safe to read. Otherwise it works like TypedView.
+ */
+template <typename T>
+class UnalignedView {
+	static_assert(std::is_trivially_copyable_v<T>, "UnalignedView needs a trivially copyable type");
+
+public:
+	using value_type = std::remove_const_t<T>;
+	using size_type = std::size_t;
+
+private:
+	using byte_pointer = std::conditional_t<std::is_const_v<T>, const std::uint8_t *, std::uint8_t *>;
+
+	constexpr static const char *size_mismatch = "Buffer size is not a multiple of the element size";
+	constexpr static const char *buf_readonly = "Buffer cannot be modified";
+	constexpr static const char *index_invalid = "Invalid index";
+
+	byte_pointer m_data;
+	std::size_t m_count;
+
+	void check(const char *function, const Buffer &buffer)
+	{
+		if (buffer.size() % sizeof(T))
+			throw Exception(Exception::makeCallString(function, buffer), size_mismatch);
+
+		m_data = static_cast<byte_pointer>(buffer.data());
+		m_count = buffer.size() / sizeof(T);
+	}
+
+public:
+	//! @brief Assignable stand-in for an element, since the element itself may be misaligned
+	class Reference {
+	private:
+		byte_pointer m_address;
+
+		friend class UnalignedView;
+
+		constexpr explicit Reference(byte_pointer address) noexcept : m_address(address) {}
+
+	public:
+		operator value_type() const noexcept
+		{
+			value_type result;
+			std::memcpy(&result, m_address, sizeof(T));
+			return result;
+		}
+
+		template <typename U = T, typename = std::enable_if_t<!std::is_const_v<U>>>
+		Reference &operator=(const value_type &value) noexcept
+		{
+			std::memcpy(m_address, &value, sizeof(T));
+			return *this;
+		}
+
+		Reference &operator=(const Reference &other) noexcept
+		{
+			return *this = static_cast<value_type>(other);
+		}
+	};
+
+	//! @brief Iterator yielding the elements by value
+	class Iterator {
+	public:
+		using difference_type = std::ptrdiff_t;
+		using value_type = UnalignedView::value_type;
+		using pointer = void;
+		using reference = Reference;
+		using iterator_category = std::input_iterator_tag;
+
+	private:
+		byte_pointer m_address;
+
+		friend class UnalignedView;
+
+		constexpr explicit Iterator(byte_pointer address) noexcept : m_address(address) {}
+
+	public:
+		constexpr Iterator() noexcept : m_address(nullptr) {}
+
+		Reference operator*() const noexcept { return Reference(m_address); }
+		Reference operator[](std::ptrdiff_t offset) const noexcept { return Reference(m_address + offset * sizeof(T)); }
+
+		Iterator &operator++() noexcept
+		{
+			m_address += sizeof(T);
+			return *this;
+		}
+
+		Iterator operator++(int) noexcept
+		{
+			auto result = *this;
+			m_address += sizeof(T);
+			return result;
+		}
+
+		Iterator &operator+=(std::ptrdiff_t amount) noexcept
+		{
+			m_address += amount * static_cast<std::ptrdiff_t>(sizeof(T));
+			return *this;
+		}
+
+		Iterator operator+(std::ptrdiff_t amount) const noexcept { return Iterator(*this) += amount; }
+
+		std::ptrdiff_t operator-(const Iterator &other) const noexcept
+		{
+			return (m_address - other.m_address) / static_cast<std::ptrdiff_t>(sizeof(T));
+		}
+
+		bool operator==(const Iterator &other) const noexcept { return m_address == other.m_address; }
+		bool operator!=(const Iterator &other) const noexcept { return m_address != other.m_address; }
+	};
+
+public:
+	constexpr UnalignedView() noexcept : m_data(nullptr), m_count(0) {}
+
+	/**
+	 * @throw Exception if the size isn't a multiple of sizeof(T), or a view of non-const |T| is made of a read-only buffer
+	 */
+	explicit UnalignedView(Buffer &buffer)
+	{
+		if constexpr (!std::is_const_v<T>) {
+			if (buffer.manager() && !buffer.manager()->flags.modify)
+				throw Exception(Exception::makeCallString(__FUNCTION__, buffer), buf_readonly);
+
+			if (buffer.manager())
+				buffer.selfDetach();
+		}
+
+		check(__FUNCTION__, buffer);
+	}
+
+	/**
+	 * @throw Exception if the size isn't a multiple of sizeof(T)
+	 */
+	template <typename U = T, typename = std::enable_if_t<std::is_const_v<U>>>
+	explicit UnalignedView(const Buffer &buffer)
+	{
+		check(__FUNCTION__, buffer);
+	}
+
+	constexpr std::size_t size() const noexcept { return m_count; }
+	constexpr bool empty() const noexcept { return !m_count; }
+
+	Iterator begin() const noexcept { return Iterator(m_data); }
+	Iterator end() const noexcept { return Iterator(m_data + m_count * sizeof(T)); }
+
+	Reference operator[](std::size_t i) const noexcept { return Reference(m_data + i * sizeof(T)); }
+
+	/**
+	 * @throw Exception if |i| is beyond the end of the view
+	 */
+	Reference at(std::size_t i) const
+	{
+		if (i >= m_count)
+			throw Exception(Exception::makeCallString(__FUNCTION__, i), index_invalid);
+
+		return Reference(m_data + i * sizeof(T));
+	}
+
+	value_type load(std::size_t i) const noexcept { return (*this)[i]; }
+
+	template <typename U = T, typename = std::enable_if_t<!std::is_const_v<U>>>
+	void store(std::size_t i, const value_type &value) const noexcept
+	{
+		(*this)[i] = value;
+	}
+};
+
+} // namespace cppx
+
+#endif // !defined(CPPX_TYPEDVIEW_H)
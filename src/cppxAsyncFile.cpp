@@ -0,0 +1,1081 @@
+#include "cppxAsyncFile.hpp"
+#include "cppxException.hpp"
+
+#include <cerrno>
+#include <cstring>
+#include <deque>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#define CPPX_ASYNCFILE_URING
+#endif
+#endif
+
+namespace {
+namespace ioexc {
+constexpr const char *no_uring = "io_uring is not available";
+constexpr const char *open_failed = "Can't open file";
+constexpr const char *stat_failed = "Can't get file size";
+constexpr const char *too_large = "File is too large for a buffer";
+constexpr const char *read_failed = "Read failed";
+constexpr const char *write_failed = "Write failed";
+constexpr const char *bad_prefetch = "Chunk size and depth must be positive, and chunks must fit in a buffer";
+} // namespace ioexc
+
+namespace fileio {
+//! @brief A read or write the engine carries through to the end of its range
+struct Transfer {
+	bool write;
+	int fd;
+	std::uint8_t *data;
+	std::size_t size;
+	std::uint64_t offset;
+	std::size_t done;
+	cppx::IoEngine::Completion completion;
+};
+
+//! @brief Bytes asked for at once; the kernel moves at most about 2 GB per call anyway
+constexpr const std::size_t max_step = std::size_t(1) << 30;
+
+inline std::size_t step(const Transfer &transfer)
+{
+	const auto left = transfer.size - transfer.done;
+	return left < max_step ? left : max_step;
+}
+
+//! @brief Moves as much of the transfer as the file allows, with blocking calls; returns 0 or an errno value
+int perform(Transfer &transfer)
+{
+	while (transfer.done < transfer.size) {
+		const auto result = transfer.write
+		                        ? ::pwrite(transfer.fd, transfer.data + transfer.done, step(transfer), static_cast<off_t>(transfer.offset + transfer.done))
+		                        : ::pread(transfer.fd, transfer.data + transfer.done, step(transfer), static_cast<off_t>(transfer.offset + transfer.done));
+
+		if (result < 0) {
+			if (errno == EINTR)
+				continue;
+
+			return errno;
+		}
+
+		if (!result)
+			return transfer.write ? EIO : 0;
+
+		transfer.done += static_cast<std::size_t>(result);
+	}
+
+	return 0;
+}
+
+inline void complete(Transfer *transfer, int error)
+{
+	transfer->completion(transfer->done, error);
+	delete transfer;
+}
+
+//! @brief The buffer an engine keeps while writing |buffer|; shares its data where copies may be dropped on any thread
+inline cppx::Buffer held(const cppx::Buffer &buffer)
+{
+#ifdef CPPX_BUFFER_ATOMIC
+	return buffer;
+#else
+	// the engine drops its reference on one of its threads, which a plain count doesn't allow
+	return buffer.clone(cppx::Buffer::onHeap);
+#endif
+}
+
+std::string describe(const char *what, int error)
+{
+	return std::string(what) + ": " + std::strerror(error);
+}
+
+int openFile(const char *function, const std::string &path, int flags)
+{
+	int fd;
+
+	do
+		fd = ::open(path.c_str(), flags | O_CLOEXEC, 0644);
+	while (fd < 0 && errno == EINTR);
+
+	if (fd < 0)
+		throw cppx::Exception(cppx::Exception::makeCallString(function, path), describe(ioexc::open_failed, errno));
+
+	return fd;
+}
+
+std::uint64_t fileSize(const char *function, int fd)
+{
+	struct stat info;
+
+	if (::fstat(fd, &info)) {
+		const auto error = errno;
+		::close(fd);
+		throw cppx::Exception(cppx::Exception::makeCallString(function, fd), describe(ioexc::stat_failed, error));
+	}
+
+	return static_cast<std::uint64_t>(info.st_size);
+}
+
+/**
+ * @brief Joins the chunks of one read() or write()
+ * @details The last chunk to finish closes the file and completes the task.
+ */
+template <typename T>
+struct Batch {
+	std::mutex mutex;
+	std::size_t pending;
+	int error = 0;
+
+	//! @brief End of the data, moved back by a chunk the file ended in
+	std::size_t length;
+
+	int fd;
+	std::string path;
+	cppx::Buffer buffer;
+	std::shared_ptr<typename cppx::IoTask<T>::State> state;
+
+	//! @brief Records a finished chunk; true for the last one
+	bool finished(std::size_t offset, std::size_t expected, std::size_t done, int failure)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		if (failure && !error)
+			error = failure;
+
+		if (done < expected && offset + done < length)
+			length = offset + done;
+
+		return !--pending;
+	}
+
+	//! @brief Gives up on |chunks| that could not be submitted; true if no other chunk is left to finish
+	bool abandon(std::size_t chunks, int failure)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		if (!error)
+			error = failure;
+
+		pending -= chunks;
+		return !pending;
+	}
+};
+} // namespace fileio
+} // namespace
+
+namespace cppx {
+
+#pragma region IoEngine
+
+struct IoEngine::Engine {
+	IoBackend kind;
+
+	explicit Engine(IoBackend backend) : kind(backend) {}
+	virtual ~Engine() = default;
+
+	//! @brief Takes over |transfer| and calls its completion once it is done; if it throws, |transfer| is still the caller's
+	virtual void submit(fileio::Transfer *transfer) = 0;
+};
+
+namespace {
+//! @brief Runs every transfer with blocking calls on one of a few threads
+class ThreadEngine : public IoEngine::Engine {
+private:
+	std::mutex m_mutex;
+	std::condition_variable m_wake;
+	std::deque<fileio::Transfer *> m_queue;
+	bool m_stopping = false;
+	std::vector<std::thread> m_workers;
+
+	void run()
+	{
+		for (;;) {
+			fileio::Transfer *transfer;
+
+			{
+				std::unique_lock<std::mutex> lock(m_mutex);
+				m_wake.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+
+				// the queue is drained before stopping, so the destructor waits for every transfer
+				if (m_queue.empty())
+					return;
+
+				transfer = m_queue.front();
+				m_queue.pop_front();
+			}
+
+			fileio::complete(transfer, fileio::perform(*transfer));
+		}
+	}
+
+public:
+	explicit ThreadEngine(std::size_t threads)
+	    : Engine(IoBackend::threads)
+	{
+		for (std::size_t i = 0; i < (threads ? threads : 1); ++i) {
+			try {
+				m_workers.emplace_back([this]() { run(); });
+			}
+			catch (const std::system_error &) {
+				// out of threads; the engine runs on those that started, and needs at least one
+				if (m_workers.empty())
+					throw;
+
+				break;
+			}
+		}
+	}
+
+	~ThreadEngine() override
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_stopping = true;
+		}
+
+		m_wake.notify_all();
+
+		for (auto &worker : m_workers)
+			worker.join();
+	}
+
+	void submit(fileio::Transfer *transfer) override
+	{
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+			m_queue.push_back(transfer);
+		}
+
+		m_wake.notify_one();
+	}
+};
+
+#ifdef CPPX_ASYNCFILE_URING
+namespace uring {
+inline int setup(unsigned entries, io_uring_params &params)
+{
+	return static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+}
+
+inline int enter(int fd, unsigned submit, unsigned wait, unsigned flags)
+{
+	return static_cast<int>(::syscall(__NR_io_uring_enter, fd, submit, wait, flags, nullptr, 0));
+}
+
+//! @brief True if the ring supports plain reads and writes, which came after the ring itself
+bool supportsReadWrite(int fd)
+{
+	constexpr const unsigned ops = 256;
+
+	std::vector<std::uint8_t> storage(sizeof(io_uring_probe) + ops * sizeof(io_uring_probe_op));
+	auto probe = reinterpret_cast<io_uring_probe *>(storage.data());
+
+	if (::syscall(__NR_io_uring_register, fd, IORING_REGISTER_PROBE, probe, ops) < 0)
+		return false;
+
+	return probe->last_op >= IORING_OP_WRITE &&
+	       (probe->ops[IORING_OP_READ].flags & IO_URING_OP_SUPPORTED) &&
+	       (probe->ops[IORING_OP_WRITE].flags & IO_URING_OP_SUPPORTED);
+}
+
+inline unsigned *field(void *ring, std::uint32_t offset)
+{
+	return reinterpret_cast<unsigned *>(static_cast<std::uint8_t *>(ring) + offset);
+}
+} // namespace uring
+
+/**
+ * @brief Submits transfers to an io_uring instance and reaps them on a thread of its own
+ * @details The rings are mapped and driven with raw system calls. At most
+ *          |depth| transfers are in flight, so the completion ring never
+ *          overflows; the others wait in a backlog. Short transfers are
+ *          resubmitted for the rest of their range.
+ */
+class UringEngine : public IoEngine::Engine {
+private:
+	int m_fd = -1;
+
+	void *m_sqRing = MAP_FAILED;
+	void *m_cqRing = MAP_FAILED;
+	std::size_t m_sqRingBytes = 0;
+	std::size_t m_cqRingBytes = 0;
+
+	io_uring_sqe *m_sqes = static_cast<io_uring_sqe *>(MAP_FAILED);
+	std::size_t m_sqesBytes = 0;
+
+	unsigned *m_sqTail;
+	unsigned *m_sqMask;
+	unsigned *m_sqArray;
+	unsigned *m_cqHead;
+	unsigned *m_cqTail;
+	unsigned *m_cqMask;
+	io_uring_cqe *m_cqes;
+
+	std::mutex m_mutex;
+	std::condition_variable m_idle;
+	std::deque<fileio::Transfer *> m_backlog;
+	std::size_t m_inflight = 0;
+	std::size_t m_depth;
+
+	//! @brief Set when the wake-up entry couldn't be submitted, so the reaper stops once idle anyway
+	bool m_stopping = false;
+
+	std::thread m_reaper;
+
+	//! @brief Fills the next submission entry; the caller holds the lock and enters the ring afterwards
+	void push(fileio::Transfer *transfer)
+	{
+		const auto tail = *m_sqTail;
+		const auto index = tail & *m_sqMask;
+		auto &entry = m_sqes[index];
+
+		std::memset(&entry, 0, sizeof(entry));
+
+		if (!transfer) {
+			entry.opcode = IORING_OP_NOP;
+		}
+		else {
+			entry.opcode = transfer->write ? IORING_OP_WRITE : IORING_OP_READ;
+			entry.fd = transfer->fd;
+			entry.addr = reinterpret_cast<std::uint64_t>(transfer->data + transfer->done);
+			entry.len = static_cast<std::uint32_t>(fileio::step(*transfer));
+			entry.off = transfer->offset + transfer->done;
+			entry.user_data = reinterpret_cast<std::uint64_t>(transfer);
+		}
+
+		m_sqArray[index] = index;
+		__atomic_store_n(m_sqTail, tail + 1, __ATOMIC_RELEASE);
+	}
+
+	/**
+	 * @brief Hands |count| pushed entries to the kernel; the caller holds the lock
+	 * @details Entries the kernel refuses are taken back off the ring and added
+	 *          to |failed| with the errno value, for the caller to complete
+	 *          after unlocking; their transfers no longer count as in flight.
+	 */
+	void flush(unsigned count, std::vector<std::pair<fileio::Transfer *, int>> &failed)
+	{
+		while (count) {
+			const auto result = uring::enter(m_fd, count, 0, 0);
+
+			if (result < 0) {
+				if (errno == EINTR || errno == EAGAIN || errno == EBUSY)
+					continue;
+
+				// without SQPOLL the kernel reads entries only inside the call, so the rest are still ours
+				const auto error = errno;
+				auto tail = *m_sqTail;
+
+				for (; count; --count) {
+					--tail;
+
+					const auto transfer = reinterpret_cast<fileio::Transfer *>(m_sqes[tail & *m_sqMask].user_data);
+					failed.emplace_back(transfer, error);
+
+					if (transfer)
+						--m_inflight;
+				}
+
+				__atomic_store_n(m_sqTail, tail, __ATOMIC_RELEASE);
+				return;
+			}
+
+			count -= static_cast<unsigned>(result);
+		}
+	}
+
+	//! @brief Moves transfers from the backlog into free slots; the caller holds the lock
+	unsigned refill()
+	{
+		unsigned pushed = 0;
+
+		while (!m_backlog.empty() && m_inflight < m_depth) {
+			push(m_backlog.front());
+			m_backlog.pop_front();
+			++m_inflight;
+			++pushed;
+		}
+
+		return pushed;
+	}
+
+	void reap()
+	{
+		std::vector<std::pair<fileio::Transfer *, int>> finished;
+		bool stopping = false;
+
+		for (;;) {
+			if (uring::enter(m_fd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+				std::this_thread::yield();
+
+			auto head = *m_cqHead;
+			const auto tail = __atomic_load_n(m_cqTail, __ATOMIC_ACQUIRE);
+
+			for (; head != tail; ++head) {
+				const auto &event = m_cqes[head & *m_cqMask];
+				auto transfer = reinterpret_cast<fileio::Transfer *>(event.user_data);
+
+				if (transfer)
+					finished.emplace_back(transfer, event.res);
+				else
+					stopping = true;
+			}
+
+			__atomic_store_n(m_cqHead, head, __ATOMIC_RELEASE);
+
+			std::size_t completed = 0;
+			std::unique_lock<std::mutex> lock(m_mutex);
+			unsigned pushed = 0;
+
+			for (auto &item : finished) {
+				auto transfer = item.first;
+				const auto result = item.second;
+
+				if (result == -EINTR || result == -EAGAIN) {
+					push(transfer);
+					++pushed;
+					item.first = nullptr;
+					continue;
+				}
+
+				if (result > 0) {
+					transfer->done += static_cast<std::size_t>(result);
+
+					if (transfer->done < transfer->size) {
+						push(transfer);
+						++pushed;
+						item.first = nullptr;
+						continue;
+					}
+				}
+
+				item.second = result < 0 ? -result : (!result && transfer->write ? EIO : 0);
+				++completed;
+			}
+
+			m_inflight -= completed;
+			pushed += refill();
+
+			// refused entries free their slots, so the backlog is tried until it goes in or is refused too
+			auto settled = finished.size();
+			flush(pushed, finished);
+
+			while (finished.size() != settled && !m_backlog.empty()) {
+				completed += finished.size() - settled;
+				settled = finished.size();
+				flush(refill(), finished);
+			}
+
+			completed += finished.size() - settled;
+
+			lock.unlock();
+
+			for (const auto &item : finished)
+				if (item.first)
+					fileio::complete(item.first, item.second);
+
+			finished.clear();
+
+			// continuations may have submitted more after the destructor's wake-up entry
+			lock.lock();
+			if (!m_inflight && m_backlog.empty()) {
+				if (stopping || m_stopping)
+					return;
+
+				if (completed)
+					m_idle.notify_all();
+			}
+		}
+	}
+
+	void unmap() noexcept
+	{
+		if (m_sqes != MAP_FAILED)
+			::munmap(m_sqes, m_sqesBytes);
+
+		if (m_cqRing != MAP_FAILED && m_cqRing != m_sqRing)
+			::munmap(m_cqRing, m_cqRingBytes);
+
+		if (m_sqRing != MAP_FAILED)
+			::munmap(m_sqRing, m_sqRingBytes);
+
+		if (m_fd >= 0)
+			::close(m_fd);
+	}
+
+public:
+	//! @brief Leaves the engine without a ring if the kernel refuses one; check usable()
+	explicit UringEngine(std::size_t depth)
+	    : Engine(IoBackend::uring)
+	{
+		io_uring_params params;
+		std::memset(&params, 0, sizeof(params));
+
+		m_fd = uring::setup(static_cast<unsigned>(depth ? depth : 1), params);
+		if (m_fd < 0 || !uring::supportsReadWrite(m_fd)) {
+			unmap();
+			m_fd = -1;
+			return;
+		}
+
+		m_sqRingBytes = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+		m_cqRingBytes = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+		if (params.features & IORING_FEAT_SINGLE_MMAP)
+			m_sqRingBytes = m_cqRingBytes = m_sqRingBytes > m_cqRingBytes ? m_sqRingBytes : m_cqRingBytes;
+
+		m_sqRing = ::mmap(nullptr, m_sqRingBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQ_RING);
+		m_cqRing = params.features & IORING_FEAT_SINGLE_MMAP
+		               ? m_sqRing
+		               : ::mmap(nullptr, m_cqRingBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_CQ_RING);
+
+		m_sqesBytes = params.sq_entries * sizeof(io_uring_sqe);
+		m_sqes = static_cast<io_uring_sqe *>(::mmap(nullptr, m_sqesBytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd, IORING_OFF_SQES));
+
+		if (m_sqRing == MAP_FAILED || m_cqRing == MAP_FAILED || m_sqes == MAP_FAILED) {
+			unmap();
+			m_fd = -1;
+			return;
+		}
+
+		m_sqTail = uring::field(m_sqRing, params.sq_off.tail);
+		m_sqMask = uring::field(m_sqRing, params.sq_off.ring_mask);
+		m_sqArray = uring::field(m_sqRing, params.sq_off.array);
+		m_cqHead = uring::field(m_cqRing, params.cq_off.head);
+		m_cqTail = uring::field(m_cqRing, params.cq_off.tail);
+		m_cqMask = uring::field(m_cqRing, params.cq_off.ring_mask);
+		m_cqes = reinterpret_cast<io_uring_cqe *>(static_cast<std::uint8_t *>(m_cqRing) + params.cq_off.cqes);
+
+		m_depth = params.sq_entries;
+
+		try {
+			m_reaper = std::thread([this]() { reap(); });
+		}
+		catch (const std::system_error &) {
+			// left unusable, so IoEngine falls back to the thread pool
+			unmap();
+			m_fd = -1;
+		}
+	}
+
+	~UringEngine() override
+	{
+		if (m_fd < 0)
+			return;
+
+		{
+			std::unique_lock<std::mutex> lock(m_mutex);
+			m_idle.wait(lock, [this]() { return !m_inflight && m_backlog.empty(); });
+
+			std::vector<std::pair<fileio::Transfer *, int>> failed;
+
+			push(nullptr);
+			flush(1, failed);
+
+			m_stopping = !failed.empty();
+		}
+
+		m_reaper.join();
+		unmap();
+	}
+
+	bool usable() const noexcept
+	{
+		return m_fd >= 0;
+	}
+
+	void submit(fileio::Transfer *transfer) override
+	{
+		std::vector<std::pair<fileio::Transfer *, int>> failed;
+
+		// the ring owns the transfer once pushed, so a refusal must not need memory
+		failed.reserve(1);
+
+		{
+			std::lock_guard<std::mutex> lock(m_mutex);
+
+			if (m_inflight >= m_depth) {
+				m_backlog.push_back(transfer);
+				return;
+			}
+
+			push(transfer);
+			++m_inflight;
+			flush(1, failed);
+
+			if (!failed.empty() && !m_inflight && m_backlog.empty())
+				m_idle.notify_all();
+		}
+
+		// a transfer the kernel refused is completed right away with the error
+		for (const auto &item : failed)
+			fileio::complete(item.first, item.second);
+	}
+};
+#endif
+} // namespace
+
+IoEngine::IoEngine(const IoOptions &options)
+    : m_chunk(options.chunk ? options.chunk : IoOptions().chunk)
+{
+#ifdef CPPX_ASYNCFILE_URING
+	if (options.backend != IoBackend::threads) {
+		std::unique_ptr<UringEngine> engine(new UringEngine(options.depth));
+
+		if (engine->usable())
+			m_engine = std::move(engine);
+	}
+#endif
+
+	if (!m_engine && options.backend == IoBackend::uring)
+		throw Exception(Exception::makeCallString(__FUNCTION__, options.depth), ioexc::no_uring);
+
+	if (!m_engine)
+		m_engine.reset(new ThreadEngine(options.threads));
+}
+
+IoEngine::~IoEngine() = default;
+
+IoBackend IoEngine::backend() const noexcept
+{
+	return m_engine->kind;
+}
+
+/** @static */
+bool IoEngine::uringAvailable() noexcept
+{
+#ifdef CPPX_ASYNCFILE_URING
+	io_uring_params params;
+	std::memset(&params, 0, sizeof(params));
+
+	const auto fd = uring::setup(1, params);
+	if (fd < 0)
+		return false;
+
+	const auto result = uring::supportsReadWrite(fd);
+	::close(fd);
+
+	return result;
+#else
+	return false;
+#endif
+}
+
+void IoEngine::submitRead(int fd, void *data, std::size_t size, std::uint64_t offset, Completion done)
+{
+	std::unique_ptr<fileio::Transfer> transfer(new fileio::Transfer{false, fd, static_cast<std::uint8_t *>(data), size, offset, 0, std::move(done)});
+
+	m_engine->submit(transfer.get());
+	transfer.release();
+}
+
+void IoEngine::submitWrite(int fd, const void *data, std::size_t size, std::uint64_t offset, Completion done)
+{
+	// the engine only reads from |data| for a write
+	std::unique_ptr<fileio::Transfer> transfer(new fileio::Transfer{true, fd, static_cast<std::uint8_t *>(const_cast<void *>(data)), size, offset, 0, std::move(done)});
+
+	m_engine->submit(transfer.get());
+	transfer.release();
+}
+
+[[nodiscard]] IoTask<Buffer> IoEngine::read(const std::string &path, const BufferManager *manager)
+{
+	auto state = std::make_shared<IoTask<Buffer>::State>();
+	const auto fd = fileio::openFile(__FUNCTION__, path, O_RDONLY);
+	const auto size = fileio::fileSize(__FUNCTION__, fd);
+
+	if (size > BufferCore::max_size) {
+		::close(fd);
+		throw Exception(Exception::makeCallString(__FUNCTION__, path, manager), ioexc::too_large);
+	}
+
+	auto batch = std::make_shared<fileio::Batch<Buffer>>();
+
+	try {
+		batch->buffer = Buffer(manager, static_cast<std::size_t>(size));
+	}
+	catch (...) {
+		::close(fd);
+		throw;
+	}
+
+	if (!size) {
+		::close(fd);
+		state->complete(std::move(batch->buffer));
+		return IoTask<Buffer>(state);
+	}
+
+	batch->pending = static_cast<std::size_t>((size + m_chunk - 1) / m_chunk);
+	batch->length = static_cast<std::size_t>(size);
+	batch->fd = fd;
+	batch->path = path;
+	batch->state = state;
+
+	const auto finish = [batch]() {
+		::close(batch->fd);
+
+		if (batch->error) {
+			batch->buffer = Buffer();
+			batch->state->fail(std::make_exception_ptr(Exception(Exception::makeCallString("read", batch->path), fileio::describe(ioexc::read_failed, batch->error))));
+			return;
+		}
+
+		// completions run on engine threads, so errors go to the task instead of being thrown
+		try {
+			if (batch->length < batch->buffer.size())
+				batch->buffer.selfErase(batch->length, batch->buffer.size());
+		}
+		catch (...) {
+			batch->buffer = Buffer();
+			batch->state->fail(std::current_exception());
+			return;
+		}
+
+		batch->state->complete(std::move(batch->buffer));
+	};
+
+	auto data = static_cast<std::uint8_t *>(batch->buffer.data());
+
+	for (std::size_t offset = 0; offset < size; offset += m_chunk) {
+		const auto bytes = size - offset < m_chunk ? static_cast<std::size_t>(size - offset) : m_chunk;
+
+		try {
+			submitRead(fd, data + offset, bytes, offset, [batch, offset, bytes, finish](std::size_t done, int error) {
+				if (batch->finished(offset, bytes, done, error))
+					finish();
+			});
+		}
+		catch (...) {
+			// the engines only fail to queue a transfer for lack of memory
+			if (batch->abandon(static_cast<std::size_t>((size - offset + m_chunk - 1) / m_chunk), ENOMEM))
+				finish();
+
+			break;
+		}
+	}
+
+	return IoTask<Buffer>(state);
+}
+
+[[nodiscard]] IoTask<std::size_t> IoEngine::write(const std::string &path, const Buffer &buffer)
+{
+	auto state = std::make_shared<IoTask<std::size_t>::State>();
+	const auto fd = fileio::openFile(__FUNCTION__, path, O_WRONLY | O_CREAT | O_TRUNC);
+	const auto size = buffer.size();
+
+	if (!size) {
+		::close(fd);
+		state->complete(0);
+		return IoTask<std::size_t>(state);
+	}
+
+	auto batch = std::make_shared<fileio::Batch<std::size_t>>();
+	batch->pending = (size + m_chunk - 1) / m_chunk;
+	batch->length = size;
+	batch->fd = fd;
+	batch->path = path;
+	batch->buffer = fileio::held(buffer);
+	batch->state = state;
+
+	const auto finish = [batch]() {
+		::close(batch->fd);
+		batch->buffer = Buffer();
+
+		if (batch->error) {
+			batch->state->fail(std::make_exception_ptr(Exception(Exception::makeCallString("write", batch->path), fileio::describe(ioexc::write_failed, batch->error))));
+			return;
+		}
+
+		batch->state->complete(batch->length);
+	};
+
+	const auto data = static_cast<const std::uint8_t *>(batch->buffer.data());
+
+	for (std::size_t offset = 0; offset < size; offset += m_chunk) {
+		const auto bytes = size - offset < m_chunk ? size - offset : m_chunk;
+
+		try {
+			submitWrite(fd, data + offset, bytes, offset, [batch, offset, bytes, finish](std::size_t done, int error) {
+				if (batch->finished(offset, bytes, done, error))
+					finish();
+			});
+		}
+		catch (...) {
+			// the engines only fail to queue a transfer for lack of memory
+			if (batch->abandon((size - offset + m_chunk - 1) / m_chunk, ENOMEM))
+				finish();
+
+			break;
+		}
+	}
+
+	return IoTask<std::size_t>(state);
+}
+
+// IoEngine
+#pragma endregion
+
+#pragma region FileReader
+
+FileReader::FileReader(IoEngine &engine, const std::string &path)
+    : m_engine(engine), m_fd(fileio::openFile(__FUNCTION__, path, O_RDONLY)), m_size(fileio::fileSize(__FUNCTION__, m_fd)), m_offset(0)
+{
+}
+
+FileReader::~FileReader()
+{
+	::close(m_fd);
+}
+
+std::uint64_t FileReader::size() const noexcept
+{
+	return m_size;
+}
+
+std::uint64_t FileReader::offset() const noexcept
+{
+	return m_offset;
+}
+
+[[nodiscard]] IoTask<std::size_t> FileReader::readInto(Buffer &target, std::size_t bytes)
+{
+	auto state = std::make_shared<IoTask<std::size_t>::State>();
+
+	if (bytes > BufferCore::max_preall)
+		bytes = BufferCore::max_preall;
+
+	if (!bytes) {
+		state->complete(0);
+		return IoTask<std::size_t>(state);
+	}
+
+	if (target.shared())
+		target.selfDetach();
+
+	if (target.preallocated() < bytes)
+		target.selfPreallocate(bytes - target.preallocated(), target.manager() ? nullptr : Buffer::onHeap);
+
+	const auto length = target.preallocated() < bytes ? target.preallocated() : bytes;
+	const auto offset = m_offset;
+	m_offset += length;
+
+	const auto tail = static_cast<std::uint8_t *>(target.data()) + target.size();
+	auto *const destination = &target;
+
+	m_engine.submitRead(m_fd, tail, length, offset, [state, destination, offset](std::size_t done, int error) {
+		if (error) {
+			state->fail(std::make_exception_ptr(Exception(Exception::makeCallString("readInto", offset), fileio::describe(ioexc::read_failed, error))));
+			return;
+		}
+
+		// the target may have been shared or shrunk meanwhile; that fails the task instead of the engine thread
+		try {
+			destination->selfCommit(done);
+		}
+		catch (...) {
+			state->fail(std::current_exception());
+			return;
+		}
+
+		state->complete(done);
+	});
+
+	return IoTask<std::size_t>(state);
+}
+
+// FileReader
+#pragma endregion
+
+#pragma region FileWriter
+
+FileWriter::FileWriter(IoEngine &engine, const std::string &path, bool append)
+    : m_engine(engine), m_fd(fileio::openFile(__FUNCTION__, path, O_WRONLY | O_CREAT | (append ? 0 : O_TRUNC))), m_offset(append ? fileio::fileSize(__FUNCTION__, m_fd) : 0)
+{
+}
+
+FileWriter::~FileWriter()
+{
+	::close(m_fd);
+}
+
+std::uint64_t FileWriter::offset() const noexcept
+{
+	return m_offset;
+}
+
+[[nodiscard]] IoTask<std::size_t> FileWriter::write(const Buffer &buffer)
+{
+	auto state = std::make_shared<IoTask<std::size_t>::State>();
+	const auto size = buffer.size();
+
+	if (!size) {
+		state->complete(0);
+		return IoTask<std::size_t>(state);
+	}
+
+	const auto offset = m_offset;
+	m_offset += size;
+
+	auto kept = fileio::held(buffer);
+	const auto data = kept.data();
+
+	m_engine.submitWrite(m_fd, data, size, offset, [state, kept = std::move(kept), offset](std::size_t done, int error) {
+		if (error) {
+			state->fail(std::make_exception_ptr(Exception(Exception::makeCallString("write", offset), fileio::describe(ioexc::write_failed, error))));
+			return;
+		}
+
+		state->complete(done);
+	});
+
+	return IoTask<std::size_t>(state);
+}
+
+// FileWriter
+#pragma endregion
+
+#pragma region PrefetchReader
+
+PrefetchReader::PrefetchReader(IoEngine &engine, const std::string &path, const PrefetchOptions &options)
+    : m_engine(engine), m_chunk(options.chunk), m_depth(options.depth), m_fd(-1), m_size(0), m_requested(0), m_allocations(0)
+{
+	if (!m_chunk || !m_depth || m_chunk > BufferCore::max_size)
+		throw Exception(Exception::makeCallString(__FUNCTION__, path, m_chunk, m_depth), ioexc::bad_prefetch);
+
+	m_fd = fileio::openFile(__FUNCTION__, path, O_RDONLY);
+	m_size = fileio::fileSize(__FUNCTION__, m_fd);
+
+	try {
+		refill();
+	}
+	catch (...) {
+		stop();
+		throw;
+	}
+}
+
+PrefetchReader::~PrefetchReader()
+{
+	stop();
+}
+
+void PrefetchReader::stop() noexcept
+{
+	// the engine may still write into the buffers of the reads in flight
+	for (const auto &read : m_reads)
+		IoTask<std::size_t>(read.state).wait();
+
+	m_reads.clear();
+	::close(m_fd);
+}
+
+std::uint64_t PrefetchReader::size() const noexcept
+{
+	return m_size;
+}
+
+std::size_t PrefetchReader::allocations() const noexcept
+{
+	return m_allocations;
+}
+
+Buffer PrefetchReader::take()
+{
+	for (auto it = m_lent.begin(); it != m_lent.end();) {
+		if (it->shared()) {
+			++it;
+			continue;
+		}
+
+		// short chunks, and chunks the trim policy shrank, can't hold a whole chunk again
+		if (it->totalsize() >= m_chunk)
+			m_free.push_back(std::move(*it));
+
+		it = m_lent.erase(it);
+	}
+
+	if (m_free.empty()) {
+		++m_allocations;
+		return Buffer::Heap(m_chunk);
+	}
+
+	auto result = std::move(m_free.back());
+	m_free.pop_back();
+
+	return result.selfCommit(m_chunk - result.size());
+}
+
+void PrefetchReader::refill()
+{
+	while (m_reads.size() < m_depth && m_requested < m_size) {
+		const auto bytes = m_size - m_requested < m_chunk ? static_cast<std::size_t>(m_size - m_requested) : m_chunk;
+
+		Pending read = {Buffer(), std::make_shared<IoTask<std::size_t>::State>()};
+
+		// the last chunk gets a buffer of its own size, since erasing the rest of a pooled one would copy it
+		if (bytes == m_chunk) {
+			read.buffer = take();
+		}
+		else {
+			read.buffer = Buffer::Heap(bytes);
+			++m_allocations;
+		}
+
+		const auto offset = m_requested;
+		const auto state = read.state;
+
+		m_engine.submitRead(m_fd, read.buffer.data(), bytes, offset, [state, offset](std::size_t done, int error) {
+			if (error) {
+				state->fail(std::make_exception_ptr(Exception(Exception::makeCallString("next", offset), fileio::describe(ioexc::read_failed, error))));
+				return;
+			}
+
+			state->complete(done);
+		});
+
+		m_requested += bytes;
+		m_reads.push_back(std::move(read));
+	}
+}
+
+[[nodiscard]] Buffer PrefetchReader::next()
+{
+	if (m_reads.empty())
+		return Buffer();
+
+	auto read = std::move(m_reads.front());
+	m_reads.pop_front();
+
+	// the reads behind this one start before waiting for it
+	refill();
+
+	const auto bytes = IoTask<std::size_t>(read.state).get();
+
+	if (!bytes) {
+		// the file shrank; the reads after this one find nothing either
+		m_requested = m_size;
+		return Buffer();
+	}
+
+	if (bytes < read.buffer.size())
+		read.buffer.selfErase(bytes, read.buffer.size());
+
+	m_lent.push_back(read.buffer);
+
+	return std::move(read.buffer);
+}
+
+// PrefetchReader
+#pragma endregion
+
+} // namespace cppx
@@ -0,0 +1,391 @@
+#include "cppxBits.hpp"
+#include "cppxException.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace {
+namespace bitexc {
+constexpr const char *size_mismatch = "Buffer sizes differ";
+constexpr const char *bit_out_of_range = "Bit index out of range";
+constexpr const char *buf_readonly = "Buffer cannot be modified";
+} // namespace bitexc
+
+namespace bits {
+constexpr const std::size_t word = sizeof(std::uint64_t);
+
+//! @brief Loads 8 bytes as a little-endian word, so bit numbering matches the byte-wise one
+inline std::uint64_t load(const std::uint8_t *p)
+{
+	std::uint64_t v;
+	std::memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	v = __builtin_bswap64(v);
+#endif
+	return v;
+}
+
+inline void store(std::uint8_t *p, std::uint64_t v)
+{
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	v = __builtin_bswap64(v);
+#endif
+	std::memcpy(p, &v, sizeof(v));
+}
+
+inline std::size_t popcount64(std::uint64_t v)
+{
+#if defined(__GNUC__)
+	return static_cast<std::size_t>(__builtin_popcountll(v));
+#else
+	v = v - ((v >> 1) & 0x5555555555555555ull);
+	v = (v & 0x3333333333333333ull) + ((v >> 2) & 0x3333333333333333ull);
+	v = (v + (v >> 4)) & 0x0F0F0F0F0F0F0F0Full;
+	return static_cast<std::size_t>((v * 0x0101010101010101ull) >> 56);
+#endif
+}
+
+inline std::size_t lowestBit(std::uint64_t v)
+{
+#if defined(__GNUC__)
+	return static_cast<std::size_t>(__builtin_ctzll(v));
+#else
+	std::size_t index = 0;
+	while (!(v & 1)) {
+		v >>= 1;
+		++index;
+	}
+	return index;
+#endif
+}
+
+inline const std::uint8_t *bytes(const cppx::Buffer &buffer)
+{
+	return static_cast<const std::uint8_t *>(buffer.data());
+}
+
+inline std::uint8_t *bytes(cppx::Buffer &buffer)
+{
+	return static_cast<std::uint8_t *>(buffer.data());
+}
+
+//! @brief Stores op(left, right) for every word and byte; the pointers may alias
+template <typename Operation>
+void combine(std::uint8_t *out, const std::uint8_t *left, const std::uint8_t *right, std::size_t size, Operation op)
+{
+	std::size_t i = 0;
+
+	for (; i + word <= size; i += word) {
+		std::uint64_t a, b;
+		std::memcpy(&a, left + i, word);
+		std::memcpy(&b, right + i, word);
+
+		const std::uint64_t result = op(a, b);
+		std::memcpy(out + i, &result, word);
+	}
+
+	for (; i < size; ++i)
+		out[i] = static_cast<std::uint8_t>(op(left[i], right[i]));
+}
+
+//! @brief Makes |target| safe to write through data()
+void prepare(cppx::Buffer &target, const char *function)
+{
+	if (!target.manager())
+		return;
+
+	if (!target.manager()->flags.modify)
+		throw cppx::Exception(function, bitexc::buf_readonly);
+
+	target.selfDetach();
+}
+
+template <typename Operation>
+cppx::Buffer combined(const char *function, const cppx::Buffer &left, const cppx::Buffer &right, const cppx::BufferManager *manager, Operation op)
+{
+	using cppx::Exception;
+
+	if (left.size() != right.size())
+		throw Exception(Exception::makeCallString(function, left, right, manager), bitexc::size_mismatch);
+
+	const auto resultManager = manager ? manager : left.manager();
+	if (!resultManager)
+		return cppx::Buffer();
+
+	auto result = cppx::Buffer(resultManager, left.size());
+	combine(bytes(result), bytes(left), bytes(right), left.size(), op);
+
+	return result;
+}
+
+template <typename Operation>
+cppx::Buffer &selfCombined(const char *function, cppx::Buffer &target, const cppx::Buffer &other, Operation op)
+{
+	using cppx::Exception;
+
+	if (target.size() != other.size())
+		throw Exception(Exception::makeCallString(function, target, other), bitexc::size_mismatch);
+
+	prepare(target, function);
+	combine(bytes(target), bytes(target), bytes(other), target.size(), op);
+
+	return target;
+}
+
+//! @brief Index of the lowest bit of |data| that differs from |unset|, or npos
+std::size_t findFirst(const std::uint8_t *data, std::size_t size, std::uint64_t unset)
+{
+	std::size_t i = 0;
+
+	for (; i + word <= size; i += word) {
+		const auto v = load(data + i) ^ unset;
+
+		if (v)
+			return i * 8 + lowestBit(v);
+	}
+
+	for (; i < size; ++i) {
+		const auto v = static_cast<std::uint8_t>(data[i] ^ unset);
+
+		if (v)
+			return i * 8 + lowestBit(v);
+	}
+
+	return cppx::Bits::npos;
+}
+
+std::uint8_t *checkedByte(cppx::Buffer &buffer, std::size_t bit, const char *function)
+{
+	using cppx::Exception;
+
+	if (bit / 8 >= buffer.size())
+		throw Exception(Exception::makeCallString(function, buffer, bit), bitexc::bit_out_of_range);
+
+	prepare(buffer, function);
+	return bytes(buffer) + bit / 8;
+}
+} // namespace bits
+} // namespace
+
+namespace cppx {
+#pragma region BitwiseOperations
+
+/** @static */
+[[nodiscard]] Buffer Bits::bitAnd(const Buffer &left, const Buffer &right, const BufferManager *manager)
+{
+	return bits::combined(__FUNCTION__, left, right, manager, [](std::uint64_t a, std::uint64_t b) { return a & b; });
+}
+
+/** @static */
+[[nodiscard]] Buffer Bits::bitOr(const Buffer &left, const Buffer &right, const BufferManager *manager)
+{
+	return bits::combined(__FUNCTION__, left, right, manager, [](std::uint64_t a, std::uint64_t b) { return a | b; });
+}
+
+/** @static */
+[[nodiscard]] Buffer Bits::bitXor(const Buffer &left, const Buffer &right, const BufferManager *manager)
+{
+	return bits::combined(__FUNCTION__, left, right, manager, [](std::uint64_t a, std::uint64_t b) { return a ^ b; });
+}
+
+/** @static */
+[[nodiscard]] Buffer Bits::bitNot(const Buffer &buffer, const BufferManager *manager)
+{
+	return bits::combined(__FUNCTION__, buffer, buffer, manager, [](std::uint64_t a, std::uint64_t) { return ~a; });
+}
+
+/** @static */
+Buffer &Bits::selfAnd(Buffer &target, const Buffer &other)
+{
+	return bits::selfCombined(__FUNCTION__, target, other, [](std::uint64_t a, std::uint64_t b) { return a & b; });
+}
+
+/** @static */
+Buffer &Bits::selfOr(Buffer &target, const Buffer &other)
+{
+	return bits::selfCombined(__FUNCTION__, target, other, [](std::uint64_t a, std::uint64_t b) { return a | b; });
+}
+
+/** @static */
+Buffer &Bits::selfXor(Buffer &target, const Buffer &other)
+{
+	return bits::selfCombined(__FUNCTION__, target, other, [](std::uint64_t a, std::uint64_t b) { return a ^ b; });
+}
+
+/** @static */
+Buffer &Bits::selfNot(Buffer &target)
+{
+	bits::prepare(target, __FUNCTION__);
+	bits::combine(bits::bytes(target), bits::bytes(target), bits::bytes(target), target.size(), [](std::uint64_t a, std::uint64_t) { return ~a; });
+
+	return target;
+}
+
+// BitwiseOperations
+#pragma endregion
+#pragma region BitQueries
+
+/** @static */
+std::size_t Bits::popcount(const Buffer &buffer) noexcept
+{
+	const auto data = bits::bytes(buffer);
+	const auto size = buffer.size();
+
+	// independent sums so the word loop vectorizes
+	std::size_t counts[4] = {};
+	std::size_t i = 0;
+
+	for (; i + 4 * bits::word <= size; i += 4 * bits::word)
+		for (std::size_t lane = 0; lane < 4; ++lane)
+			counts[lane] += bits::popcount64(bits::load(data + i + lane * bits::word));
+
+	std::size_t result = counts[0] + counts[1] + counts[2] + counts[3];
+
+	for (; i < size; ++i)
+		result += bits::popcount64(data[i]);
+
+	return result;
+}
+
+/** @static */
+std::size_t Bits::findFirstSet(const Buffer &buffer) noexcept
+{
+	return bits::findFirst(bits::bytes(buffer), buffer.size(), 0);
+}
+
+/** @static */
+std::size_t Bits::findFirstUnset(const Buffer &buffer) noexcept
+{
+	return bits::findFirst(bits::bytes(buffer), buffer.size(), ~std::uint64_t(0));
+}
+
+/** @static */
+bool Bits::test(const Buffer &buffer, std::size_t bit)
+{
+	if (bit / 8 >= buffer.size())
+		throw Exception(Exception::makeCallString(__FUNCTION__, buffer, bit), bitexc::bit_out_of_range);
+
+	return (bits::bytes(buffer)[bit / 8] >> (bit % 8)) & 1;
+}
+
+/** @static */
+void Bits::set(Buffer &buffer, std::size_t bit, bool value)
+{
+	const auto byte = bits::checkedByte(buffer, bit, __FUNCTION__);
+	const auto mask = static_cast<std::uint8_t>(1u << (bit % 8));
+
+	*byte = static_cast<std::uint8_t>(value ? *byte | mask : *byte & ~mask);
+}
+
+/** @static */
+void Bits::clear(Buffer &buffer, std::size_t bit)
+{
+	set(buffer, bit, false);
+}
+
+// BitQueries
+#pragma endregion
+#pragma region BitShifts
+
+/** @static */
+[[nodiscard]] Buffer Bits::shiftLeft(const Buffer &buffer, std::size_t count, const BufferManager *manager)
+{
+	auto result = buffer.clone(manager);
+	return selfShiftLeft(result, count);
+}
+
+/** @static */
+[[nodiscard]] Buffer Bits::shiftRight(const Buffer &buffer, std::size_t count, const BufferManager *manager)
+{
+	auto result = buffer.clone(manager);
+	return selfShiftRight(result, count);
+}
+
+/** @static */
+Buffer &Bits::selfShiftLeft(Buffer &target, std::size_t count)
+{
+	bits::prepare(target, __FUNCTION__);
+
+	const auto data = bits::bytes(target);
+	const auto size = target.size();
+
+	if (!size || !count)
+		return target;
+
+	if (count / 8 >= size) {
+		std::memset(data, 0, size);
+		return target;
+	}
+
+	const auto byteShift = count / 8;
+	const auto bitShift = static_cast<unsigned>(count % 8);
+
+	std::memmove(data + byteShift, data, size - byteShift);
+	std::memset(data, 0, byteShift);
+
+	if (!bitShift)
+		return target;
+
+	// from the end down, so every word still reads the unshifted byte below it
+	std::size_t i = size;
+
+	for (; i >= bits::word + 1; i -= bits::word) {
+		const auto at = i - bits::word;
+		const auto carry = static_cast<std::uint64_t>(data[at - 1] >> (8 - bitShift));
+
+		bits::store(data + at, (bits::load(data + at) << bitShift) | carry);
+	}
+
+	for (; i > 1; --i)
+		data[i - 1] = static_cast<std::uint8_t>((data[i - 1] << bitShift) | (data[i - 2] >> (8 - bitShift)));
+
+	data[0] = static_cast<std::uint8_t>(data[0] << bitShift);
+
+	return target;
+}
+
+/** @static */
+Buffer &Bits::selfShiftRight(Buffer &target, std::size_t count)
+{
+	bits::prepare(target, __FUNCTION__);
+
+	const auto data = bits::bytes(target);
+	const auto size = target.size();
+
+	if (!size || !count)
+		return target;
+
+	if (count / 8 >= size) {
+		std::memset(data, 0, size);
+		return target;
+	}
+
+	const auto byteShift = count / 8;
+	const auto bitShift = static_cast<unsigned>(count % 8);
+
+	std::memmove(data, data + byteShift, size - byteShift);
+	std::memset(data + size - byteShift, 0, byteShift);
+
+	if (!bitShift)
+		return target;
+
+	// from the start up, so every word still reads the unshifted byte above it
+	std::size_t i = 0;
+
+	for (; i + bits::word < size; i += bits::word) {
+		const auto carry = static_cast<std::uint64_t>(data[i + bits::word]) << (64 - bitShift);
+
+		bits::store(data + i, (bits::load(data + i) >> bitShift) | carry);
+	}
+
+	for (; i + 1 < size; ++i)
+		data[i] = static_cast<std::uint8_t>((data[i] >> bitShift) | (data[i + 1] << (8 - bitShift)));
+
+	data[size - 1] = static_cast<std::uint8_t>(data[size - 1] >> bitShift);
+
+	return target;
+}
+
+// BitShifts
+#pragma endregion
+} // namespace cppx
@@ -1,13 +1,34 @@
 #include "cppxBuffer.hpp"
 #include "cppxException.hpp"
+#include "cppxParallel.hpp"
 
+#if defined(CPPX_BUFFER_TRACE)
+#include "cppxTrace.hpp"
+#endif
+
+#include <atomic>
+#include <cstdlib>
 #include <cstring>
 #include <iomanip>
+#include <mutex>
+#include <new>
 #include <sstream>
 
 #define BUFFER_COPY(dest, src, size) memcpy(dest, src, size)
 #define BUFFER_MOVE(dest, src, size) memmove(dest, src, size)
 
+#if defined(CPPX_BUFFER_STATS)
+#define BUFFER_STAT(manager, update) (manager)->counters.update
+#else // defined(CPPX_BUFFER_STATS)
+#define BUFFER_STAT(manager, update)
+#endif // defined(CPPX_BUFFER_STATS)
+
+#if defined(CPPX_BUFFER_TRACE)
+#define BUFFER_TRACE(type, size, manager) BufferTrace::record(TraceEvent::type, size, manager)
+#else // defined(CPPX_BUFFER_TRACE)
+#define BUFFER_TRACE(type, size, manager)
+#endif // defined(CPPX_BUFFER_TRACE)
+
 #if defined(CPPX_BUFFER_BUILTINS)
 #define BUFFER_SAFE_INCREASE(x, onoverflow)                  \
 	{                                                        \
@@ -62,6 +83,7 @@ constexpr const char *buf_insufficient = "Insufficient buffer storage";
 constexpr const char *buf_no_manager = "No suitable data manager";
 constexpr const char *buf_cannot_copy = "Cannot copy to new buffer";
 constexpr const char *buf_size_overflow = "Size overflow";
+constexpr const char *buf_empty_pattern = "Empty fill pattern";
 
 constexpr const char *buf_fail_ref_overflow = "Reference count overflow";
 constexpr const char *buf_fail_ref_underflow = "Reference count underflow";
@@ -75,6 +97,63 @@ constexpr const char *invalid_range = "Invalid range";
 constexpr const char *invalid_index = "Invalid index";
 constexpr const char *no_data = "Data not avaliable";
 } // namespace bufexc
+
+namespace arena {
+//! @brief Start of an arena allocation; counts the slices still alive
+struct Arena {
+	std::atomic<std::size_t> slices;
+};
+
+//! @brief Precedes the data of every slice
+struct Slice {
+	Arena *arena;
+};
+
+inline std::size_t sliceBytes(std::size_t size)
+{
+	return sizeof(Slice) + (size + alignof(Slice) - 1) / alignof(Slice) * alignof(Slice);
+}
+
+//! @brief Allocates an arena for |slices| slices of |bytes| in total, including their headers
+inline Arena *create(std::size_t bytes, std::size_t slices)
+{
+	auto memory = ::operator new(sizeof(Arena) + bytes, std::nothrow);
+
+	if (!memory)
+		return nullptr;
+
+	auto result = reinterpret_cast<Arena *>(memory);
+	new (&result->slices) std::atomic<std::size_t>(slices);
+
+	return result;
+}
+
+//! @brief Writes the header of the slice at |cursor| and advances it past the slice
+inline std::uint8_t *carve(Arena *owner, std::uint8_t *&cursor, std::size_t size)
+{
+	new (cursor) Slice{owner};
+
+	auto data = cursor + sizeof(Slice);
+	cursor += sliceBytes(size);
+
+	return data;
+}
+
+inline std::uint8_t *begin(Arena *owner)
+{
+	return reinterpret_cast<std::uint8_t *>(owner) + sizeof(Arena);
+}
+
+inline void release(void *data)
+{
+	auto owner = (reinterpret_cast<Slice *>(data) - 1)->arena;
+
+	if (owner->slices.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+		owner->slices.~atomic();
+		::operator delete(owner);
+	}
+}
+} // namespace arena
 } // namespace
 
 namespace cppx {
@@ -94,9 +173,104 @@ std::string BufferManager::toString() const
 	       "\", \"flags\"="s +
 	       (flags.memory ? "m"s : ""s) +
 	       (flags.modify ? "w"s : ""s) +
+	       (flags.cow ? "c"s : ""s) +
 	       "}"s;
 }
 
+#if defined(CPPX_BUFFER_STATS)
+std::string BufferStats::toString() const
+{
+	std::stringstream stream;
+
+	stream << "{\"allocations\"=" << allocations
+	       << ", \"releases\"=" << releases
+	       << ", \"bytesLive\"=" << bytesLive
+	       << ", \"bytesPeak\"=" << bytesPeak
+	       << ", \"reallocations\"=" << reallocations
+	       << ", \"copies\"=" << copies
+	       << ", \"bytesCopied\"=" << bytesCopied
+	       << ", \"detaches\"=" << detaches
+	       << ", \"preallocationHits\"=" << preallocationHits
+	       << ", \"preallocationMisses\"=" << preallocationMisses
+	       << "}";
+
+	return stream.str();
+}
+
+void BufferManager::Counters::allocated(std::size_t bytes) noexcept
+{
+	++allocations;
+
+	const auto live = bytesLive += bytes;
+	auto peak = bytesPeak.load(std::memory_order_relaxed);
+
+	while (live > peak && !bytesPeak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+		;
+}
+
+void BufferManager::Counters::reallocated(std::size_t from, std::size_t to) noexcept
+{
+	++reallocations;
+
+	if (to < from) {
+		bytesLive -= from - to;
+		return;
+	}
+
+	const auto live = bytesLive += to - from;
+	auto peak = bytesPeak.load(std::memory_order_relaxed);
+
+	while (live > peak && !bytesPeak.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+		;
+}
+
+void BufferManager::Counters::released(std::size_t bytes) noexcept
+{
+	++releases;
+	bytesLive -= bytes;
+}
+
+void BufferManager::Counters::copied(std::size_t bytes) noexcept
+{
+	++copies;
+	bytesCopied += bytes;
+}
+
+BufferStats BufferManager::stats() const noexcept
+{
+	return {
+	    counters.allocations.load(),
+	    counters.releases.load(),
+	    counters.bytesLive.load(),
+	    counters.bytesPeak.load(),
+	    counters.reallocations.load(),
+	    counters.copies.load(),
+	    counters.bytesCopied.load(),
+	    counters.detaches.load(),
+	    counters.preallocationHits.load(),
+	    counters.preallocationMisses.load()};
+}
+
+void BufferManager::resetStats() const noexcept
+{
+	counters.allocations = 0;
+	counters.releases = 0;
+	counters.bytesLive = 0;
+	counters.bytesPeak = 0;
+	counters.reallocations = 0;
+	counters.copies = 0;
+	counters.bytesCopied = 0;
+	counters.detaches = 0;
+	counters.preallocationHits = 0;
+	counters.preallocationMisses = 0;
+}
+
+void BufferManager::dumpStats(std::ostream &stream) const
+{
+	stream << name << ": " << stats().toString() << '\n';
+}
+#endif // defined(CPPX_BUFFER_STATS)
+
 // BufferManager
 #pragma endregion
 #pragma region BufferCore
@@ -110,12 +284,40 @@ BufferCore::BufferCore(
 {
 }
 
-std::uint8_t *BufferCore::tryAllocateRaw(std::size_t bytes)
+std::uint8_t *BufferCore::tryAllocateRaw(std::size_t bytes, bool zeroed)
 {
 	if (!m_manager->flags.memory || bytes > BufferCore::max_size)
 		return nullptr;
 
-	return reinterpret_cast<std::uint8_t *>(m_manager->alloc(bytes));
+	const bool native = zeroed && m_manager->zeroAlloc;
+	const auto address = reinterpret_cast<std::uint8_t *>(native ? m_manager->zeroAlloc(bytes) : m_manager->alloc(bytes));
+
+	if (address) {
+		if (zeroed && !native)
+			std::memset(address, 0, bytes);
+
+		BUFFER_STAT(m_manager, allocated(bytes));
+		BUFFER_TRACE(ALLOCATE, bytes, m_manager);
+	}
+
+	return address;
+}
+
+bool BufferCore::tryReallocateRaw(std::size_t bytes)
+{
+	if (!m_manager->flags.memory || !m_manager->reallocate || !m_address || bytes > BufferCore::max_size)
+		return false;
+
+	const auto oldBytes = std::size_t(m_size) + m_preall;
+	const auto address = reinterpret_cast<std::uint8_t *>(m_manager->reallocate(m_address, oldBytes, bytes));
+
+	if (!address)
+		return false;
+
+	BUFFER_STAT(m_manager, reallocated(oldBytes, bytes));
+
+	m_address = address;
+	return true;
 }
 
 bool BufferCore::tryDeallocateRaw()
@@ -123,6 +325,9 @@ bool BufferCore::tryDeallocateRaw()
 	if (!m_manager->flags.memory)
 		return false;
 
+	if (m_address)
+		BUFFER_STAT(m_manager, released(m_size + m_preall));
+
 	m_manager->release(m_address, m_size + m_preall);
 	m_address = nullptr;
 
@@ -131,13 +336,22 @@ bool BufferCore::tryDeallocateRaw()
 
 bool BufferCore::tryShare()
 {
+#ifdef CPPX_BUFFER_ATOMIC
+	// fails instead of wrapping around, so the caller makes a copy. threads racing
+	// past the check overshoot the limit by one each, which the headroom absorbs
+	if (m_refcount.load(std::memory_order_relaxed) >= max_refcount)
+		return false;
+
+	m_refcount.fetch_add(1, std::memory_order_relaxed);
+#else
 	BUFFER_SAFE_INCREASE(m_refcount, { return false; })
+#endif
 	return true;
 }
 
-bool BufferCore::tryAllocate(std::size_t bytes)
+bool BufferCore::tryAllocate(std::size_t bytes, bool zeroed)
 {
-	m_address = tryAllocateRaw(bytes);
+	m_address = tryAllocateRaw(bytes, zeroed);
 	m_preall = 0;
 	m_size = static_cast<std::uint32_t>(bytes);
 	return bool(m_address);
@@ -157,24 +371,41 @@ bool BufferCore::tryDeallocate()
 /** @static */
 void BufferCore::shareOrDetach(BufferCore *&core)
 {
+	// |core| still belongs to the source, so it is copied without being released
 	if (core)
 		if (!core->tryShare())
-			detach(core);
+			core = duplicate(core);
 }
 
 /** @static */
-void BufferCore::detach(BufferCore *&core)
+BufferCore *BufferCore::duplicate(const BufferCore *core)
 {
-	if (core->m_refcount > 1) {
-		auto newCore = new BufferCore(core->m_manager, core->m_preall, core->m_size, core->m_address);
+	BufferCore *newCore = nullptr;
+	create(newCore, core->m_manager, core->m_preall, core->m_size, core->m_address);
 
-		if (core->m_manager->flags.modify) {
-			if (!newCore->tryAllocate(core->m_size + core->m_preall)) {
-				delete newCore;
-				throw Exception(__FUNCTION__, bufexc::bufcore_fail_detach);
-			}
+	if (core->m_manager->flags.memory && core->m_address) {
+		newCore->m_address = newCore->tryAllocateRaw(core->m_size + core->m_preall);
+
+		if (!newCore->m_address) {
+			destroy(newCore);
+			throw Exception(__FUNCTION__, bufexc::bufcore_fail_detach);
 		}
 
+		BUFFER_COPY(newCore->m_address, core->m_address, core->m_size);
+	}
+
+	BUFFER_STAT(core->m_manager, detaches++);
+	BUFFER_TRACE(DETACH, core->m_size, core->m_manager);
+
+	return newCore;
+}
+
+/** @static */
+void BufferCore::detach(BufferCore *&core)
+{
+	if (core->m_refcount > 1) {
+		const auto newCore = duplicate(core);
+
 		release(core);
 		core = newCore;
 	}
@@ -183,21 +414,57 @@ void BufferCore::detach(BufferCore *&core)
 /** @static */
 void BufferCore::create(BufferCore *&core, const BufferManager *manager, std::uint16_t preall, std::uint32_t size, std::uint8_t *address)
 {
-	core = new BufferCore(manager, preall, size, address);
+	if (manager->coreAlloc) {
+		const auto storage = manager->coreAlloc(sizeof(BufferCore));
+
+		if (!storage)
+			throw std::bad_alloc();
+
+		core = new (storage) BufferCore(manager, preall, size, address);
+	}
+	else
+		core = new BufferCore(manager, preall, size, address);
+
+	BUFFER_TRACE(CREATE, size, manager);
+}
+
+/** @static */
+void BufferCore::destroy(BufferCore *core) noexcept
+{
+	const auto manager = core->m_manager;
+
+	if (manager->coreRelease) {
+		core->~BufferCore();
+		manager->coreRelease(core, sizeof(BufferCore));
+	}
+	else
+		delete core;
 }
 
 /** @static */
 void BufferCore::release(BufferCore *&core)
 {
-	if (core->m_address && core->m_refcount <= 1) {
-		if (core->m_manager->flags.memory)
+#ifdef CPPX_BUFFER_ATOMIC
+	// the last owner sees 1 and frees the core; the others only drop their reference.
+	// a sole owner skips the atomic update, since no one else can add a reference
+	if (core->m_refcount.load(std::memory_order_acquire) == 1 || core->m_refcount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+#else
+	if (core->m_refcount <= 1) {
+#endif
+		BUFFER_TRACE(RELEASE, core->m_size + core->m_preall, core->m_manager);
+
+		if (core->m_address && core->m_manager->flags.memory) {
+			BUFFER_STAT(core->m_manager, released(core->m_size + core->m_preall));
 			core->m_manager->release(core->m_address, core->m_size + core->m_preall);
+		}
 
-		delete core;
+		destroy(core);
 	}
+#ifndef CPPX_BUFFER_ATOMIC
 	else {
 		BUFFER_SAFE_DECREASE(core->m_refcount, {});
 	}
+#endif
 
 	core = nullptr;
 }
@@ -212,6 +479,15 @@ void BufferCore::change(BufferCore *&core, BufferCore *const newcore)
 	shareOrDetach(core);
 }
 
+/** @static */
+void BufferCore::adopt(BufferCore *&core, BufferCore *const newcore)
+{
+	if (core)
+		release(core);
+
+	core = newcore;
+}
+
 // BufferCore
 #pragma endregion
 
@@ -220,23 +496,51 @@ void BufferCore::change(BufferCore *&core, BufferCore *const newcore)
 /** @static */
 const BufferManager Buffer::staticManager = {
     "staticManager",
-    {0, 0},
+    {0, 0, 0},
     BufferManager::defaultAllocateFunction,
     BufferManager::defaultReleaseFunction};
 
 /** @static */
 const BufferManager Buffer::stackManager = {
     "stackManager",
-    {0, 1},
+    {0, 1, 0},
     BufferManager::defaultAllocateFunction,
     BufferManager::defaultReleaseFunction};
 
 /** @static */
 const BufferManager Buffer::heapManager = {
     "heapManager",
-    {1, 1},
-    [](std::size_t size) -> void * { return new std::uint8_t[size]; },
-    [](void *ptr, std::size_t size) -> void { delete[] reinterpret_cast<std::uint8_t *>(ptr); }};
+    {1, 1, 0},
+    [](std::size_t size) -> void * { return std::malloc(size ? size : 1); },
+    [](void *ptr, std::size_t) -> void { std::free(ptr); },
+    [](void *ptr, std::size_t, std::size_t size) -> void * { return std::realloc(ptr, size ? size : 1); },
+    [](std::size_t size) -> void * { return std::calloc(size ? size : 1, 1); }};
+
+/** @static */
+const BufferManager Buffer::heapCowManager = {
+    "heapCowManager",
+    {1, 1, 1},
+    Buffer::heapManager.alloc,
+    Buffer::heapManager.release,
+    Buffer::heapManager.reallocate,
+    Buffer::heapManager.zeroAlloc};
+
+/** @static */
+const BufferManager Buffer::arenaManager = {
+    "arenaManager",
+    {1, 1, 0},
+    [](std::size_t size) -> void * {
+	    auto owner = arena::create(arena::sliceBytes(size), 1);
+	    if (!owner)
+		    return nullptr;
+
+	    auto cursor = arena::begin(owner);
+	    return arena::carve(owner, cursor, size);
+    },
+    [](void *ptr, std::size_t) -> void { arena::release(ptr); }};
+
+/** @static */
+Buffer::TrimPolicy Buffer::s_trimPolicy = {0.0f, 4096};
 
 Buffer::Buffer(const BufferManager *manager, std::size_t size)
     : m_core(nullptr)
@@ -281,10 +585,11 @@ Buffer::Buffer(const Buffer &other)
 	BufferCore::shareOrDetach(m_core);
 }
 
-Buffer::Buffer(Buffer &&other)
+Buffer::Buffer(Buffer &&other) noexcept
     : m_core(other.m_core)
 {
-	BufferCore::shareOrDetach(m_core);
+	// the reference moves with the core, so the count stays as it is
+	other.m_core = nullptr;
 }
 
 Buffer::~Buffer()
@@ -298,9 +603,9 @@ Buffer::~Buffer()
 	return Buffer(&heapManager, size);
 }
 
-/** @static */ [[nodiscard]] Buffer Buffer::HeapPreall(std::size_t size)
+/** @static */ [[nodiscard]] Buffer Buffer::Preall(const BufferManager *manager, std::size_t size)
 {
-	auto result = Buffer(&heapManager, size > BufferCore::max_preall ? BufferCore::max_preall : size);
+	auto result = Buffer(manager, size > BufferCore::max_preall ? BufferCore::max_preall : size);
 
 	result.m_core->m_preall = result.m_core->m_size;
 	result.m_core->m_size = 0;
@@ -308,6 +613,11 @@ Buffer::~Buffer()
 	return result;
 }
 
+/** @static */ [[nodiscard]] Buffer Buffer::HeapPreall(std::size_t size)
+{
+	return Preall(&heapManager, size);
+}
+
 /** @static */ [[nodiscard]] Buffer Buffer::HeapFrom(void *ptr, std::size_t size)
 {
 	auto result = Buffer(&heapManager, size);
@@ -317,6 +627,68 @@ Buffer::~Buffer()
 	return result;
 }
 
+/** @static */ [[nodiscard]] Buffer Buffer::Zeroed(const BufferManager *manager, std::size_t size)
+{
+	if (!manager->flags.memory)
+		throw Exception(
+		    Exception::makeCallString(__FUNCTION__, manager, size),
+		    bufexc::buf_no_alloc);
+
+	Buffer result;
+	BufferCore::create(result.m_core, manager);
+
+	if (size)
+		if (!result.m_core->tryAllocate(size, true))
+			throw Exception(
+			    Exception::makeCallString(__FUNCTION__, manager, size),
+			    bufexc::buf_fail_alloc);
+
+	return result;
+}
+
+/** @static */ [[nodiscard]] Buffer Buffer::HeapZeroed(std::size_t size)
+{
+	return Zeroed(&heapManager, size);
+}
+
+/** @static */ [[nodiscard]] std::vector<Buffer> Buffer::HeapBatch(const std::vector<Span> &spans)
+{
+	std::size_t bytes = 0;
+
+	for (const auto &span : spans) {
+		if (span.second > BufferCore::max_size)
+			throw Exception(Exception::makeCallString(__FUNCTION__, spans.size()), bufexc::buf_size_overflow);
+
+		bytes += arena::sliceBytes(span.second);
+	}
+
+	std::vector<Buffer> result(spans.size());
+
+	if (spans.empty())
+		return result;
+
+	auto owner = arena::create(bytes, spans.size());
+	if (!owner)
+		throw Exception(Exception::makeCallString(__FUNCTION__, spans.size()), bufexc::buf_fail_alloc);
+
+	auto cursor = arena::begin(owner);
+
+	for (std::size_t i = 0; i < spans.size(); ++i) {
+		const auto size = spans[i].second;
+		const auto data = arena::carve(owner, cursor, size);
+
+		if (size)
+			BUFFER_COPY(data, spans[i].first, size);
+
+		BufferCore::create(result[i].m_core, &arenaManager, 0, static_cast<std::uint32_t>(size), data);
+
+		// counted per slice, matching the per-slice releases
+		BUFFER_STAT(&arenaManager, allocated(size));
+	}
+
+	return result;
+}
+
 /** @static */ [[nodiscard]] Buffer Buffer::Stack(void *ptr, std::size_t size)
 {
 	return Buffer(&stackManager, ptr, size);
@@ -329,6 +701,9 @@ Buffer::~Buffer()
 
 Buffer &Buffer::operator=(const Buffer &other)
 {
+	if (m_core == other.m_core)
+		return *this;
+
 	if (m_core) {
 		BufferCore::change(m_core, other.m_core);
 	}
@@ -341,16 +716,16 @@ Buffer &Buffer::operator=(const Buffer &other)
 	return *this;
 }
 
-Buffer &Buffer::operator=(Buffer &&other)
+Buffer &Buffer::operator=(Buffer &&other) noexcept
 {
-	if (m_core) {
-		BufferCore::change(m_core, other.m_core);
-	}
-	else {
-		m_core = other.m_core;
+	if (this == &other)
+		return *this;
 
-		BufferCore::shareOrDetach(m_core);
-	}
+	if (m_core)
+		BufferCore::release(m_core);
+
+	m_core = other.m_core;
+	other.m_core = nullptr;
 
 	return *this;
 }
@@ -398,6 +773,11 @@ std::size_t Buffer::size() const noexcept
 	return m_core ? m_core->m_size : 0u;
 }
 
+bool Buffer::shared() const noexcept
+{
+	return m_core && m_core->m_refcount > 1;
+}
+
 std::size_t Buffer::preallocated() const noexcept
 {
 	return m_core ? m_core->m_preall : 0u;
@@ -435,6 +815,9 @@ Buffer::byte_t &Buffer::at(std::size_t i)
 		if (m_core->m_size <= i)
 			throw Exception(Exception::makeCallString(__FUNCTION__, i), bufexc::buf_ref_index_invalid);
 
+		if (m_core->m_manager->flags.cow && m_core->m_refcount > 1)
+			BufferCore::detach(m_core);
+
 		return m_core->m_address[i];
 	}
 	else {
@@ -442,6 +825,14 @@ Buffer::byte_t &Buffer::at(std::size_t i)
 	}
 }
 
+Buffer &Buffer::selfDetach()
+{
+	if (m_core)
+		BufferCore::detach(m_core);
+
+	return *this;
+}
+
 // Buffer
 #pragma endregion
 
@@ -647,7 +1038,10 @@ Buffer &Buffer::selfPreallocate(std::size_t extra, const BufferManager *imanager
 		if (m_core)
 			BUFFER_COPY(newCore->m_address, m_core->m_address, m_core->m_size);
 
-		BufferCore::change(m_core, newCore);
+		BufferCore::adopt(m_core, newCore);
+	}
+	else if (m_core->m_manager == resultManager && m_core->tryReallocateRaw(totalsize() + cappedExtra)) {
+		m_core->m_preall += static_cast<std::uint16_t>(cappedExtra);
 	}
 	else {
 		auto newAddress = m_core->tryAllocateRaw(totalsize() + cappedExtra);
@@ -662,9 +1056,78 @@ Buffer &Buffer::selfPreallocate(std::size_t extra, const BufferManager *imanager
 		m_core->m_preall += static_cast<std::uint16_t>(cappedExtra);
 	}
 
+	BUFFER_TRACE(GROW, totalsize(), m_core->m_manager);
+
 	return *this;
 }
 
+Buffer &Buffer::selfShrinkToFit()
+{
+	if (!m_core || !m_core->m_preall || m_core->m_refcount > 1 || !m_core->m_manager->flags.memory)
+		return *this;
+
+	if (m_core->m_size && m_core->tryReallocateRaw(m_core->m_size)) {
+		m_core->m_preall = 0;
+		return *this;
+	}
+
+	std::uint8_t *newAddress = nullptr;
+
+	if (m_core->m_size) {
+		newAddress = m_core->tryAllocateRaw(m_core->m_size);
+		if (!newAddress)
+			throw Exception(__FUNCTION__, bufexc::buf_fail_alloc);
+
+		BUFFER_COPY(newAddress, m_core->m_address, m_core->m_size);
+	}
+
+	if (!m_core->tryDeallocateRaw())
+		throw Exception(__FUNCTION__, bufexc::buf_fail_release);
+
+	m_core->m_address = newAddress;
+	m_core->m_preall = 0;
+
+	return *this;
+}
+
+Buffer &Buffer::selfCommit(std::size_t bytes)
+{
+	if (!bytes)
+		return *this;
+
+	if (!m_core || bytes > m_core->m_preall)
+		throw Exception(Exception::makeCallString(__FUNCTION__, bytes), bufexc::buf_insufficient);
+
+	if (!m_core->m_manager->flags.modify || m_core->m_refcount > 1)
+		throw Exception(Exception::makeCallString(__FUNCTION__, bytes), bufexc::buf_readonly);
+
+	m_core->m_size += static_cast<std::uint32_t>(bytes);
+	m_core->m_preall -= static_cast<std::uint16_t>(bytes);
+
+	return *this;
+}
+
+/** @static */
+void Buffer::setTrimPolicy(const TrimPolicy &policy) noexcept
+{
+	s_trimPolicy = policy;
+}
+
+/** @static */
+Buffer::TrimPolicy Buffer::trimPolicy() noexcept
+{
+	return s_trimPolicy;
+}
+
+void Buffer::trimIfIdle()
+{
+	if (s_trimPolicy.ratio <= 0.0f || m_core->m_preall < s_trimPolicy.minimum)
+		return;
+
+	if (m_core->m_preall >= s_trimPolicy.ratio * m_core->m_size)
+		selfShrinkToFit();
+}
+
 [[nodiscard]] Buffer Buffer::clone(const BufferManager *manager) const
 {
 	if (!m_core)
@@ -681,6 +1144,7 @@ Buffer &Buffer::selfPreallocate(std::size_t extra, const BufferManager *imanager
 	Buffer result = Buffer(resultManager, m_core->m_size);
 
 	BUFFER_COPY(result.m_core->m_address, m_core->m_address, m_core->m_size);
+	BUFFER_STAT(resultManager, copied(m_core->m_size));
 
 	return result;
 }
@@ -706,6 +1170,7 @@ Buffer &Buffer::selfClone(const Buffer &other, const BufferManager *imanager)
 		throw Exception(Exception::makeCallString(__FUNCTION__, other, imanager), bufexc::buf_fail_alloc);
 
 	BUFFER_COPY(m_core->m_address, other.m_core->m_address, m_core->m_size);
+	BUFFER_STAT(resultManager, copied(m_core->m_size));
 
 	return *this;
 }
@@ -729,6 +1194,7 @@ Buffer &Buffer::selfClone(const Buffer &other, const BufferManager *imanager)
 	auto result = Buffer(newManager, end - start);
 
 	BUFFER_COPY(result.m_core->m_address, m_core->m_address + start, result.m_core->m_size);
+	BUFFER_STAT(newManager, copied(result.m_core->m_size));
 
 	return result;
 }
@@ -794,27 +1260,16 @@ Buffer &Buffer::selfReverse(std::size_t start, std::size_t end)
 		if (!m_core->m_manager->flags.memory)
 			throw Exception(Exception::makeCallString(__FUNCTION__, start, end), bufexc::buf_insufficient);
 
-		BufferCore *newCore = nullptr;
-		BufferCore::create(newCore, m_core->m_manager);
-
-		if (!newCore->tryAllocate(m_core->m_size))
-			throw Exception(Exception::makeCallString(__FUNCTION__, start, end), bufexc::buf_fail_alloc);
-
-		for (std::size_t i = 0, j = m_core->m_size - 1; i < m_core->m_size; ++i, --j) {
-			newCore->m_address[i] = m_core->m_address[j];
-		}
-
-		BufferCore::change(m_core, newCore);
+		BufferCore::detach(m_core);
 	}
-	else {
-		const std::size_t halfway = start + (end - start) / 2;
 
-		for (std::size_t i = start, j = end - 1; i < halfway; ++i, --j) {
-			const std::uint8_t left = m_core->m_address[i];
+	const std::size_t halfway = start + (end - start) / 2;
 
-			m_core->m_address[i] = m_core->m_address[j];
-			m_core->m_address[j] = left;
-		}
+	for (std::size_t i = start, j = end - 1; i < halfway; ++i, --j) {
+		const std::uint8_t left = m_core->m_address[i];
+
+		m_core->m_address[i] = m_core->m_address[j];
+		m_core->m_address[j] = left;
 	}
 
 	return *this;
@@ -833,6 +1288,96 @@ Buffer &Buffer::selfReverse()
 	return selfReverse(0, size());
 }
 
+Buffer &Buffer::selfFill(std::size_t start, std::size_t end, byte_t value)
+{
+	if (end < start || end > size())
+		throw Exception(Exception::makeCallString(__FUNCTION__, start, end, value), bufexc::invalid_range);
+
+	if (start == end)
+		return *this;
+
+	if (!m_core->m_manager->flags.modify)
+		throw Exception(Exception::makeCallString(__FUNCTION__, start, end, value), bufexc::buf_readonly);
+
+	if (m_core->m_refcount > 1) {
+		if (!m_core->m_manager->flags.memory)
+			throw Exception(Exception::makeCallString(__FUNCTION__, start, end, value), bufexc::buf_insufficient);
+
+		BufferCore::detach(m_core);
+	}
+
+	std::memset(m_core->m_address + start, value, end - start);
+
+	return *this;
+}
+
+Buffer &Buffer::selfFill(Iterator start, Iterator end, byte_t value)
+{
+	if (start.m_data != end.m_data || start.m_data != m_core || end.m_index < start.m_index)
+		throw Exception(Exception::makeCallString(__FUNCTION__, start.toString(), end.toString(), value), bufexc::invalid_range);
+
+	return selfFill(start.m_index, end.m_index, value);
+}
+
+Buffer &Buffer::selfFill(byte_t value)
+{
+	return selfFill(0, size(), value);
+}
+
+Buffer &Buffer::selfFill(std::size_t start, std::size_t end, const Buffer &pattern)
+{
+	if (end < start || end > size())
+		throw Exception(Exception::makeCallString(__FUNCTION__, start, end, pattern), bufexc::invalid_range);
+
+	if (start == end)
+		return *this;
+
+	if (!pattern.size())
+		throw Exception(Exception::makeCallString(__FUNCTION__, start, end, pattern), bufexc::buf_empty_pattern);
+
+	if (!m_core->m_manager->flags.modify)
+		throw Exception(Exception::makeCallString(__FUNCTION__, start, end, pattern), bufexc::buf_readonly);
+
+	// keeps the pattern alive and unchanged if it shares the data being filled
+	const Buffer source = pattern.m_core == m_core ? pattern.range(0, pattern.size(), Buffer::onHeap) : pattern;
+
+	if (m_core->m_refcount > 1) {
+		if (!m_core->m_manager->flags.memory)
+			throw Exception(Exception::makeCallString(__FUNCTION__, start, end, pattern), bufexc::buf_insufficient);
+
+		BufferCore::detach(m_core);
+	}
+
+	const auto target = m_core->m_address + start;
+	const auto length = end - start;
+
+	// one copy of the pattern, then the filled part is doubled until the range is full
+	std::size_t filled = source.size() < length ? source.size() : length;
+	BUFFER_COPY(target, source.m_core->m_address, filled);
+
+	while (filled < length) {
+		const auto chunk = filled < length - filled ? filled : length - filled;
+
+		BUFFER_COPY(target + filled, target, chunk);
+		filled += chunk;
+	}
+
+	return *this;
+}
+
+Buffer &Buffer::selfFill(Iterator start, Iterator end, const Buffer &pattern)
+{
+	if (start.m_data != end.m_data || start.m_data != m_core || end.m_index < start.m_index)
+		throw Exception(Exception::makeCallString(__FUNCTION__, start.toString(), end.toString(), pattern), bufexc::invalid_range);
+
+	return selfFill(start.m_index, end.m_index, pattern);
+}
+
+Buffer &Buffer::selfFill(const Buffer &pattern)
+{
+	return selfFill(0, size(), pattern);
+}
+
 [[nodiscard]] Buffer Buffer::insert(std::size_t index, const Buffer &value, const BufferManager *imanager) const
 {
 	if (index > size())
@@ -853,6 +1398,8 @@ Buffer &Buffer::selfReverse()
 	if (value.m_core)
 		BUFFER_COPY(newBuffer.m_core->m_address + index, value.m_core->m_address, value.size());
 
+	BUFFER_STAT(newManager, copied(newBuffer.size()));
+
 	return newBuffer;
 }
 
@@ -886,12 +1433,26 @@ Buffer &Buffer::selfInsert(std::size_t index, const Buffer &value)
 	if (!value)
 		return *this;
 
-	if (value.m_core->m_size > m_core->m_preall || m_core->m_refcount > 1) {
+	// inserting a buffer into itself needs the original data intact, so it always copies
+	if (value.m_core->m_size > m_core->m_preall || m_core->m_refcount > 1 || value.m_core == m_core) {
 		const auto newSize = m_core->m_size + value.m_core->m_size;
 
 		if (!m_core->m_manager->flags.memory)
 			throw Exception(Exception::makeCallString(__FUNCTION__, index, value), bufexc::buf_insufficient);
 
+		BUFFER_STAT(m_core->m_manager, preallocationMisses++);
+		BUFFER_TRACE(GROW, newSize, m_core->m_manager);
+
+		if (m_core->m_refcount == 1 && value.m_core != m_core && m_core->tryReallocateRaw(newSize)) {
+			BUFFER_MOVE(m_core->m_address + index + value.m_core->m_size, m_core->m_address + index, m_core->m_size - index);
+			BUFFER_COPY(m_core->m_address + index, value.m_core->m_address, value.m_core->m_size);
+
+			m_core->m_size = static_cast<std::uint32_t>(newSize);
+			m_core->m_preall = 0;
+
+			return *this;
+		}
+
 		BufferCore *newCore = nullptr;
 		BufferCore::create(newCore, m_core->m_manager);
 
@@ -902,7 +1463,9 @@ Buffer &Buffer::selfInsert(std::size_t index, const Buffer &value)
 		BUFFER_COPY(newCore->m_address + index, value.m_core->m_address, value.m_core->m_size);
 		BUFFER_COPY(newCore->m_address + index + value.m_core->m_size, m_core->m_address + index, m_core->m_size - index);
 
-		BufferCore::change(m_core, newCore);
+		BUFFER_STAT(m_core->m_manager, copied(newSize));
+
+		BufferCore::adopt(m_core, newCore);
 	}
 	else {
 		BUFFER_MOVE(m_core->m_address + index + value.m_core->m_size, m_core->m_address + index, m_core->m_size - index);
@@ -910,6 +1473,8 @@ Buffer &Buffer::selfInsert(std::size_t index, const Buffer &value)
 
 		m_core->m_size += value.m_core->m_size;
 		m_core->m_preall -= static_cast<std::uint16_t>(value.m_core->m_size);
+
+		BUFFER_STAT(m_core->m_manager, preallocationHits++);
 	}
 
 	return *this;
@@ -947,7 +1512,7 @@ Buffer &Buffer::selfAppend(const Buffer &right)
 	auto result = Buffer(newManager, size() - end + start);
 
 	BUFFER_COPY(result.m_core->m_address, m_core->m_address, start);
-	BUFFER_COPY(result.m_core->m_address, m_core->m_address + end, size() - end);
+	BUFFER_COPY(result.m_core->m_address + start, m_core->m_address + end, size() - end);
 
 	return result;
 }
@@ -972,8 +1537,15 @@ Buffer &Buffer::selfErase(std::size_t start, std::size_t end)
 		throw Exception(Exception::makeCallString(__FUNCTION__, start, end), bufexc::buf_readonly);
 
 	const auto newSize = size() - end + start;
+	const auto fits = end - start <= BufferCore::max_preall - m_core->m_preall;
+
+	// a tail too long for the preallocated space is given back in place, without a copy
+	if (!fits && end == size() && m_core->m_refcount == 1 && m_core->tryReallocateRaw(newSize + m_core->m_preall)) {
+		m_core->m_size = static_cast<std::uint32_t>(newSize);
+		return *this;
+	}
 
-	if (m_core->m_refcount > 1 || m_core->m_preall > (BufferCore::max_preall) - (end - start)) {
+	if (m_core->m_refcount > 1 || !fits) {
 		if (!m_core->m_manager->flags.memory)
 			throw Exception(Exception::makeCallString(__FUNCTION__, start, end), bufexc::buf_no_alloc);
 
@@ -984,14 +1556,16 @@ Buffer &Buffer::selfErase(std::size_t start, std::size_t end)
 			throw Exception(Exception::makeCallString(__FUNCTION__, start, end), bufexc::buf_fail_alloc);
 
 		BUFFER_COPY(newCore->m_address, m_core->m_address, start);
-		BUFFER_COPY(newCore->m_address, m_core->m_address + end, size() - end);
+		BUFFER_COPY(newCore->m_address + start, m_core->m_address + end, size() - end);
 
-		BufferCore::change(m_core, newCore);
+		BufferCore::adopt(m_core, newCore);
 	}
 	else {
 		BUFFER_MOVE(m_core->m_address + start, m_core->m_address + end, size() - end);
 		m_core->m_preall += static_cast<std::uint16_t>(end - start);
 		m_core->m_size -= static_cast<std::uint32_t>(end - start);
+
+		trimIfIdle();
 	}
 
 	return *this;
@@ -1051,4 +1625,159 @@ std::string Buffer::represent(std::uint8_t form) const
 // BufferOperations
 #pragma endregion
 
+#pragma region BufferParallelOperations
+
+int Buffer::compare(const Buffer &other, const Parallel &policy) const
+{
+	const auto thissize = size(), othersize = other.size();
+
+	if (thissize < othersize)
+		return -1;
+	else if (thissize > othersize)
+		return 1;
+
+	// the lowest differing chunk decides; chunks past it are skipped
+	std::mutex resultMutex;
+	std::atomic<std::size_t> firstDifference(thissize);
+	int result = 0;
+
+	policy.forEachChunk(thissize, [&](std::size_t begin, std::size_t end) {
+		if (begin > firstDifference.load(std::memory_order_relaxed))
+			return;
+
+		const int chunkResult = memcmp(m_core->m_address + begin, other.m_core->m_address + begin, end - begin);
+
+		if (chunkResult) {
+			std::lock_guard<std::mutex> lock(resultMutex);
+
+			if (begin < firstDifference.load(std::memory_order_relaxed)) {
+				firstDifference.store(begin, std::memory_order_relaxed);
+				result = chunkResult < 0 ? -1 : 1;
+			}
+		}
+	});
+
+	return result;
+}
+
+[[nodiscard]] Buffer Buffer::clone(const Parallel &policy, const BufferManager *manager) const
+{
+	if (!m_core)
+		return Buffer();
+
+	const BufferManager *resultManager = manager ? manager : m_core->m_manager;
+
+	if (!resultManager)
+		throw Exception(Exception::makeCallString(__FUNCTION__, manager), bufexc::buf_no_manager);
+
+	if (!(resultManager->flags.memory && resultManager->flags.modify))
+		throw Exception(Exception::makeCallString(__FUNCTION__, manager), bufexc::buf_no_alloc);
+
+	Buffer result = Buffer(resultManager, m_core->m_size);
+
+	policy.forEachChunk(m_core->m_size, [&](std::size_t begin, std::size_t end) {
+		BUFFER_COPY(result.m_core->m_address + begin, m_core->m_address + begin, end - begin);
+	});
+
+	BUFFER_STAT(resultManager, copied(m_core->m_size));
+
+	return result;
+}
+
+[[nodiscard]] Buffer Buffer::reverse(const Parallel &policy, const BufferManager *imanager) const
+{
+	const BufferManager *newManager = imanager ? imanager : manager();
+
+	if (!newManager)
+		throw Exception(Exception::makeCallString(__FUNCTION__, imanager), bufexc::buf_no_manager);
+
+	auto result = Buffer(newManager, size());
+
+	policy.forEachChunk(size(), [&](std::size_t begin, std::size_t end) {
+		const auto last = m_core->m_address + m_core->m_size - 1;
+
+		for (std::size_t i = begin; i < end; ++i)
+			result.m_core->m_address[i] = *(last - i);
+	});
+
+	return result;
+}
+
+[[nodiscard]] Buffer Buffer::insert(std::size_t index, const Buffer &value, const Parallel &policy, const BufferManager *imanager) const
+{
+	if (index > size())
+		throw Exception(Exception::makeCallString(__FUNCTION__, index, value), bufexc::iter_invalid);
+
+	const BufferManager *newManager = imanager ? imanager : manager();
+
+	if (!newManager)
+		throw Exception(Exception::makeCallString(__FUNCTION__, index, value, imanager), bufexc::buf_no_manager);
+
+	Buffer newBuffer = Buffer(newManager, size() + value.size());
+
+	const auto valueEnd = index + value.size();
+
+	// copies the part of [from, to) that falls into the chunk
+	const auto copyPart = [&newBuffer](std::size_t begin, std::size_t end, std::size_t from, std::size_t to, const std::uint8_t *source) {
+		const auto first = begin > from ? begin : from;
+		const auto last = end < to ? end : to;
+
+		if (first < last)
+			BUFFER_COPY(newBuffer.m_core->m_address + first, source + (first - from), last - first);
+	};
+
+	policy.forEachChunk(newBuffer.size(), [&](std::size_t begin, std::size_t end) {
+		copyPart(begin, end, 0, index, m_core ? m_core->m_address : nullptr);
+		copyPart(begin, end, index, valueEnd, value.m_core ? value.m_core->m_address : nullptr);
+		copyPart(begin, end, valueEnd, newBuffer.size(), m_core ? m_core->m_address + index : nullptr);
+	});
+
+	BUFFER_STAT(newManager, copied(newBuffer.size()));
+
+	return newBuffer;
+}
+
+std::string Buffer::represent(std::uint8_t form, const Parallel &policy) const
+{
+	if (!m_core || m_core->m_size == 0)
+		return "null";
+
+	const bool hex = (form & Representation::HEX) == Representation::HEX;
+	const bool binary = !hex && (form & Representation::BINARY) == Representation::BINARY;
+
+	if (!hex && !binary)
+		return "null";
+
+	const char *const digits = (form & Representation::LOWERCASE) ? "0123456789abcdef" : "0123456789ABCDEF";
+	const std::size_t prefix = (form & Representation::PREFIXED) == Representation::PREFIXED ? 2 : 0;
+	const std::size_t width = hex ? 2 : 8;
+
+	std::string result(prefix + m_core->m_size * width, '0');
+
+	if (prefix)
+		result[1] = hex ? 'x' : 'b';
+
+	policy.forEachChunk(m_core->m_size, [&](std::size_t begin, std::size_t end) {
+		char *out = &result[prefix + begin * width];
+
+		for (std::size_t index = begin; index < end; ++index) {
+			const auto v = m_core->m_address[index];
+
+			if (hex) {
+				*out++ = digits[v >> 4];
+				*out++ = digits[v & 0xF];
+			}
+			else {
+				for (int bit = 7; bit >= 0; --bit)
+					*out++ = ((v >> bit) & 1) ? '1' : '0';
+			}
+		}
+	});
+
+	return result;
+}
+
+// BufferParallelOperations
+#pragma endregion
+
 } // namespace cppx
\ No newline at end of file
@@ -0,0 +1,247 @@
+#include "cppxCache.hpp"
+#include "cppxException.hpp"
+#include "cppxHash.hpp"
+
+#include <atomic>
+#include <cstring>
+#include <list>
+#include <mutex>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+namespace cacheexc {
+constexpr const char *no_shards = "A cache needs at least one shard";
+} // namespace cacheexc
+
+namespace caching {
+inline bool sameContents(const cppx::Buffer &left, const cppx::Buffer &right)
+{
+	return left.size() == right.size() && (!left.size() || !std::memcmp(left.data(), right.data(), left.size()));
+}
+} // namespace caching
+} // namespace
+
+namespace cppx {
+
+double CacheStats::hitRatio() const noexcept
+{
+	return hits + misses ? static_cast<double>(hits) / static_cast<double>(hits + misses) : 0.0;
+}
+
+std::string CacheStats::toString() const
+{
+	std::stringstream stream;
+
+	stream << "{\"hits\"=" << hits
+	       << ", \"misses\"=" << misses
+	       << ", \"insertions\"=" << insertions
+	       << ", \"evictions\"=" << evictions
+	       << ", \"entries\"=" << entries
+	       << ", \"bytes\"=" << bytes
+	       << "}";
+
+	return stream.str();
+}
+
+struct BufferCache::Shard {
+	struct Entry {
+		std::uint64_t hash;
+		Buffer key;
+		Buffer value;
+		std::size_t bytes;
+	};
+
+	using Order = std::list<Entry>;
+
+	mutable std::mutex mutex;
+
+	//! @brief Most recently used first
+	Order order;
+
+	//! @brief Keyed by key hash; equal hashes are told apart by comparing keys
+	std::unordered_multimap<std::uint64_t, Order::iterator> index;
+
+	//! @brief The bytes of all shards together, which the budget applies to
+	std::atomic<std::size_t> *total = nullptr;
+	std::size_t bytes = 0;
+
+	std::uint64_t hits = 0;
+	std::uint64_t misses = 0;
+	std::uint64_t insertions = 0;
+	std::uint64_t evictions = 0;
+
+	//! @brief The index entry of |key|, or index.end(); the caller holds the lock
+	decltype(index)::iterator find(std::uint64_t hash, const Buffer &key)
+	{
+		const auto range = index.equal_range(hash);
+
+		for (auto it = range.first; it != range.second; ++it)
+			if (caching::sameContents(it->second->key, key))
+				return it;
+
+		return index.end();
+	}
+
+	void remove(decltype(index)::iterator found)
+	{
+		bytes -= found->second->bytes;
+		total->fetch_sub(found->second->bytes, std::memory_order_relaxed);
+		order.erase(found->second);
+		index.erase(found);
+	}
+
+	//! @brief Evicts least recently used entries other than |keep| until the cache fits |budget|
+	void evictToBudget(std::size_t budget, const Entry *keep = nullptr)
+	{
+		while (total->load(std::memory_order_relaxed) > budget && !order.empty() && &order.back() != keep) {
+			auto &victim = order.back();
+			remove(find(victim.hash, victim.key));
+			++evictions;
+		}
+	}
+};
+
+BufferCache::BufferCache(std::size_t budget, std::size_t shards)
+    : m_shardCount(shards), m_budget(budget)
+{
+	if (!shards)
+		throw Exception(Exception::makeCallString(__FUNCTION__, budget, shards), cacheexc::no_shards);
+
+	m_shards.reset(new Shard[shards]);
+
+	for (std::size_t i = 0; i < shards; ++i)
+		m_shards[i].total = &m_bytes;
+}
+
+BufferCache::~BufferCache() = default;
+
+BufferCache::Shard &BufferCache::shardOf(std::uint64_t hash) const noexcept
+{
+	// the high bits, since the maps bucket by the low ones
+	return m_shards[(hash >> 40) % m_shardCount];
+}
+
+bool BufferCache::get(const Buffer &key, Buffer &value)
+{
+	const auto hash = Hasher::hash(key);
+	auto &shard = shardOf(hash);
+
+	std::lock_guard<std::mutex> lock(shard.mutex);
+
+	const auto found = shard.find(hash, key);
+
+	if (found == shard.index.end()) {
+		++shard.misses;
+		return false;
+	}
+
+	++shard.hits;
+	shard.order.splice(shard.order.begin(), shard.order, found->second);
+	value = found->second->value;
+
+	return true;
+}
+
+bool BufferCache::put(const Buffer &key, const Buffer &value)
+{
+	const auto hash = Hasher::hash(key);
+	auto &shard = shardOf(hash);
+
+	// the copy is made outside the lock; the key's own buffer may be changed later
+	auto ownKey = key.size() ? key.clone(Buffer::onHeap) : Buffer::Heap(0);
+	const auto bytes = ownKey.totalsize() + value.totalsize();
+
+	{
+		std::lock_guard<std::mutex> lock(shard.mutex);
+
+		const auto found = shard.find(hash, key);
+		if (found != shard.index.end())
+			shard.remove(found);
+
+		if (bytes > m_budget)
+			return false;
+
+		shard.order.push_front(Shard::Entry{hash, std::move(ownKey), value, bytes});
+		shard.index.emplace(hash, shard.order.begin());
+		shard.bytes += bytes;
+		m_bytes.fetch_add(bytes, std::memory_order_relaxed);
+		++shard.insertions;
+
+		shard.evictToBudget(m_budget, &shard.order.front());
+	}
+
+	// the shard ran out of older entries; the others make room, one lock at a time
+	for (std::size_t i = 1; i < m_shardCount && m_bytes.load(std::memory_order_relaxed) > m_budget; ++i) {
+		auto &other = m_shards[(static_cast<std::size_t>(&shard - m_shards.get()) + i) % m_shardCount];
+
+		std::lock_guard<std::mutex> lock(other.mutex);
+		other.evictToBudget(m_budget);
+	}
+
+	return true;
+}
+
+bool BufferCache::erase(const Buffer &key)
+{
+	const auto hash = Hasher::hash(key);
+	auto &shard = shardOf(hash);
+
+	std::lock_guard<std::mutex> lock(shard.mutex);
+
+	const auto found = shard.find(hash, key);
+	if (found == shard.index.end())
+		return false;
+
+	shard.remove(found);
+	return true;
+}
+
+void BufferCache::clear()
+{
+	for (std::size_t i = 0; i < m_shardCount; ++i) {
+		std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+
+		m_shards[i].index.clear();
+		m_shards[i].order.clear();
+		m_bytes.fetch_sub(m_shards[i].bytes, std::memory_order_relaxed);
+		m_shards[i].bytes = 0;
+	}
+}
+
+std::size_t BufferCache::budget() const noexcept
+{
+	return m_budget;
+}
+
+CacheStats BufferCache::stats() const
+{
+	CacheStats result = {};
+
+	for (std::size_t i = 0; i < m_shardCount; ++i) {
+		const auto &shard = m_shards[i];
+		std::lock_guard<std::mutex> lock(shard.mutex);
+
+		result.hits += shard.hits;
+		result.misses += shard.misses;
+		result.insertions += shard.insertions;
+		result.evictions += shard.evictions;
+		result.entries += shard.index.size();
+		result.bytes += shard.bytes;
+	}
+
+	return result;
+}
+
+void BufferCache::resetStats()
+{
+	for (std::size_t i = 0; i < m_shardCount; ++i) {
+		auto &shard = m_shards[i];
+		std::lock_guard<std::mutex> lock(shard.mutex);
+
+		shard.hits = shard.misses = shard.insertions = shard.evictions = 0;
+	}
+}
+
+} // namespace cppx
@@ -0,0 +1,321 @@
+#include "cppxChecksum.hpp"
+#include "cppxException.hpp"
+
+#include <array>
+#include <cstring>
+
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+#define CHECKSUM_CRC32C_SSE42
+#include <nmmintrin.h>
+#endif
+
+namespace {
+namespace sumexc {
+constexpr const char *invalid_range = "Invalid range";
+} // namespace sumexc
+
+namespace crc {
+//! @brief Reflected CRC-32C polynomial
+constexpr const std::uint32_t poly = 0x82F63B78u;
+
+struct Tables {
+	std::uint32_t slice[8][256];
+
+	Tables()
+	{
+		for (std::uint32_t i = 0; i < 256; ++i) {
+			std::uint32_t c = i;
+
+			for (int bit = 0; bit < 8; ++bit)
+				c = (c & 1) ? (c >> 1) ^ poly : c >> 1;
+
+			slice[0][i] = c;
+		}
+
+		for (std::uint32_t i = 0; i < 256; ++i)
+			for (int k = 1; k < 8; ++k)
+				slice[k][i] = (slice[k - 1][i] >> 8) ^ slice[0][slice[k - 1][i] & 0xFF];
+	}
+};
+
+const Tables &tables()
+{
+	static const Tables s_tables;
+	return s_tables;
+}
+
+//! @brief Multiplies a and b modulo the polynomial (reflected bit order)
+std::uint32_t multmodp(std::uint32_t a, std::uint32_t b)
+{
+	std::uint32_t m = 1u << 31, p = 0;
+
+	for (;;) {
+		if (a & m) {
+			p ^= b;
+			if ((a & (m - 1)) == 0)
+				break;
+		}
+
+		m >>= 1;
+		b = (b & 1) ? (b >> 1) ^ poly : b >> 1;
+	}
+
+	return p;
+}
+
+//! @brief Returns x^(n * 2^k) modulo the polynomial
+std::uint32_t x2nmodp(std::uint64_t n, unsigned k)
+{
+	static const auto s_powers = []() {
+		std::array<std::uint32_t, 64> powers = {};
+		std::uint32_t p = 1u << 30; // x^1
+
+		for (auto &power : powers) {
+			power = p;
+			p = multmodp(p, p);
+		}
+
+		return powers;
+	}();
+
+	std::uint32_t p = 1u << 31; // x^0
+
+	for (; n; n >>= 1, ++k)
+		if (n & 1)
+			p = multmodp(s_powers[k & 63], p);
+
+	return p;
+}
+
+//! @brief Shifts a raw crc register over |bytes| zero bytes
+inline std::uint32_t shift(std::uint32_t reg, std::size_t bytes)
+{
+	return multmodp(x2nmodp(bytes, 3), reg);
+}
+
+std::uint32_t portable(std::uint32_t reg, const std::uint8_t *p, std::size_t size)
+{
+	const auto &t = tables().slice;
+
+#if !defined(__BYTE_ORDER__) || __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	for (; size >= 8; p += 8, size -= 8) {
+		std::uint64_t word;
+		std::memcpy(&word, p, sizeof(word));
+		word ^= reg;
+
+		reg = t[7][word & 0xFF] ^ t[6][(word >> 8) & 0xFF] ^
+		      t[5][(word >> 16) & 0xFF] ^ t[4][(word >> 24) & 0xFF] ^
+		      t[3][(word >> 32) & 0xFF] ^ t[2][(word >> 40) & 0xFF] ^
+		      t[1][(word >> 48) & 0xFF] ^ t[0][word >> 56];
+	}
+#endif
+
+	for (; size; ++p, --size)
+		reg = (reg >> 8) ^ t[0][(reg ^ *p) & 0xFF];
+
+	return reg;
+}
+
+#if defined(CHECKSUM_CRC32C_SSE42)
+//! @brief Bytes per lane of the interleaved hardware loop
+constexpr const std::size_t lane_size = 4096;
+
+/**
+ * @brief Three independent crc32 streams hide the latency of the instruction;
+ *        the lanes are merged with the same shift used by crc32cCombine
+ */
+__attribute__((target("sse4.2"))) std::uint32_t hardware(std::uint32_t reg, const std::uint8_t *p, std::size_t size)
+{
+	static const std::uint32_t s_laneShift = x2nmodp(lane_size, 3);
+
+	for (; size >= 3 * lane_size; p += 3 * lane_size, size -= 3 * lane_size) {
+		std::uint64_t c0 = reg, c1 = 0, c2 = 0;
+
+		for (std::size_t i = 0; i < lane_size; i += 8) {
+			std::uint64_t w0, w1, w2;
+			std::memcpy(&w0, p + i, 8);
+			std::memcpy(&w1, p + lane_size + i, 8);
+			std::memcpy(&w2, p + 2 * lane_size + i, 8);
+
+			c0 = _mm_crc32_u64(c0, w0);
+			c1 = _mm_crc32_u64(c1, w1);
+			c2 = _mm_crc32_u64(c2, w2);
+		}
+
+		reg = multmodp(s_laneShift, multmodp(s_laneShift, std::uint32_t(c0)) ^ std::uint32_t(c1)) ^ std::uint32_t(c2);
+	}
+
+	std::uint64_t c = reg;
+
+	for (; size >= 8; p += 8, size -= 8) {
+		std::uint64_t word;
+		std::memcpy(&word, p, 8);
+		c = _mm_crc32_u64(c, word);
+	}
+
+	reg = std::uint32_t(c);
+
+	for (; size; ++p, --size)
+		reg = _mm_crc32_u8(reg, *p);
+
+	return reg;
+}
+#endif // defined(CHECKSUM_CRC32C_SSE42)
+
+inline bool accelerated()
+{
+#if defined(CHECKSUM_CRC32C_SSE42)
+	static const bool s_supported = __builtin_cpu_supports("sse4.2");
+	return s_supported;
+#else
+	return false;
+#endif
+}
+} // namespace crc
+
+namespace adler {
+constexpr const std::uint32_t base = 65521u;
+
+//! @brief Largest n such that 255n(n+1)/2 + (n+1)(base-1) fits in 32 bits
+constexpr const std::size_t nmax = 5552;
+} // namespace adler
+} // namespace
+
+namespace cppx {
+#pragma region CRC32C
+
+std::uint32_t crc32c(const void *data, std::size_t size, std::uint32_t crc) noexcept
+{
+	if (!data || !size)
+		return crc;
+
+	const auto p = reinterpret_cast<const std::uint8_t *>(data);
+
+#if defined(CHECKSUM_CRC32C_SSE42)
+	if (crc::accelerated())
+		return ~crc::hardware(~crc, p, size);
+#endif
+
+	return ~crc::portable(~crc, p, size);
+}
+
+std::uint32_t crc32c(const Buffer &buffer, std::uint32_t crc) noexcept
+{
+	return crc32c(buffer.data(), buffer.size(), crc);
+}
+
+std::uint32_t crc32c(const Buffer &buffer, std::size_t start, std::size_t end, std::uint32_t crc)
+{
+	if (end < start || end > buffer.size())
+		throw Exception(Exception::makeCallString(__FUNCTION__, buffer, start, end, crc), sumexc::invalid_range);
+
+	return crc32c(reinterpret_cast<const std::uint8_t *>(buffer.data()) + start, end - start, crc);
+}
+
+std::uint32_t crc32c(const std::vector<Buffer> &chain, std::uint32_t crc) noexcept
+{
+	for (const auto &buffer : chain)
+		crc = crc32c(buffer, crc);
+
+	return crc;
+}
+
+std::uint32_t crc32cCombine(std::uint32_t crcA, std::uint32_t crcB, std::size_t sizeB) noexcept
+{
+	return crc::shift(crcA, sizeB) ^ crcB;
+}
+
+bool crc32cAccelerated() noexcept
+{
+	return crc::accelerated();
+}
+
+std::uint32_t crc32cPortable(const void *data, std::size_t size, std::uint32_t crc) noexcept
+{
+	if (!data || !size)
+		return crc;
+
+	return ~crc::portable(~crc, reinterpret_cast<const std::uint8_t *>(data), size);
+}
+
+// CRC32C
+#pragma endregion
+#pragma region Adler32
+
+std::uint32_t adler32(const void *data, std::size_t size, std::uint32_t adler) noexcept
+{
+	if (!data || !size)
+		return adler;
+
+	auto p = reinterpret_cast<const std::uint8_t *>(data);
+	std::uint32_t a = adler & 0xFFFF, b = adler >> 16;
+
+	while (size) {
+		auto block = size < adler::nmax ? size : adler::nmax;
+		size -= block;
+
+		for (; block >= 16; block -= 16, p += 16) {
+			for (int i = 0; i < 16; ++i) {
+				a += p[i];
+				b += a;
+			}
+		}
+
+		for (; block; --block, ++p) {
+			a += *p;
+			b += a;
+		}
+
+		a %= adler::base;
+		b %= adler::base;
+	}
+
+	return a | (b << 16);
+}
+
+std::uint32_t adler32(const Buffer &buffer, std::uint32_t adler) noexcept
+{
+	return adler32(buffer.data(), buffer.size(), adler);
+}
+
+std::uint32_t adler32(const Buffer &buffer, std::size_t start, std::size_t end, std::uint32_t adler)
+{
+	if (end < start || end > buffer.size())
+		throw Exception(Exception::makeCallString(__FUNCTION__, buffer, start, end, adler), sumexc::invalid_range);
+
+	return adler32(reinterpret_cast<const std::uint8_t *>(buffer.data()) + start, end - start, adler);
+}
+
+std::uint32_t adler32(const std::vector<Buffer> &chain, std::uint32_t adler) noexcept
+{
+	for (const auto &buffer : chain)
+		adler = adler32(buffer, adler);
+
+	return adler;
+}
+
+std::uint32_t adler32Combine(std::uint32_t adlerA, std::uint32_t adlerB, std::size_t sizeB) noexcept
+{
+	const std::uint32_t remainder = static_cast<std::uint32_t>(sizeB % adler::base);
+
+	std::uint32_t sum1 = adlerA & 0xFFFF;
+	std::uint32_t sum2 = (remainder * sum1) % adler::base;
+
+	sum1 += (adlerB & 0xFFFF) + adler::base - 1;
+	sum2 += (adlerA >> 16) + (adlerB >> 16) + adler::base - remainder;
+
+	if (sum1 >= adler::base)
+		sum1 -= adler::base;
+	if (sum1 >= adler::base)
+		sum1 -= adler::base;
+	if (sum2 >= (adler::base << 1))
+		sum2 -= (adler::base << 1);
+	if (sum2 >= adler::base)
+		sum2 -= adler::base;
+
+	return sum1 | (sum2 << 16);
+}
+
+// Adler32
+#pragma endregion
+} // namespace cppx
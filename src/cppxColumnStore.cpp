@@ -0,0 +1,240 @@
+#include "cppxColumnStore.hpp"
+
+#include <cstdint>
+#include <cstring>
+
+namespace {
+namespace colexc {
+constexpr const char *no_columns = "A store needs at least one column";
+constexpr const char *zero_width = "Column width must not be 0";
+constexpr const char *invalid_column = "Invalid column";
+constexpr const char *invalid_row = "Invalid row";
+constexpr const char *width_mismatch = "Type size doesn't match the column width";
+constexpr const char *column_count_mismatch = "Buffer count doesn't match the column count";
+constexpr const char *row_count_mismatch = "Buffers hold different numbers of rows";
+constexpr const char *size_overflow = "Size overflow";
+constexpr const char *no_alloc = "Can't create store: manager has allocations disallowed";
+} // namespace colexc
+
+namespace columnar {
+constexpr const std::size_t min_capacity = 16;
+
+//! @brief Copies one field of every record; a constant |Width| lets memcpy become a single move
+template <std::size_t Width>
+void gather(std::uint8_t *target, const std::uint8_t *source, std::size_t stride, std::size_t count)
+{
+	for (std::size_t row = 0; row < count; ++row)
+		std::memcpy(target + row * Width, source + row * stride, Width);
+}
+
+void gather(std::uint8_t *target, const std::uint8_t *source, std::size_t stride, std::size_t count, std::size_t width)
+{
+	switch (width) {
+	case 1: return gather<1>(target, source, stride, count);
+	case 2: return gather<2>(target, source, stride, count);
+	case 4: return gather<4>(target, source, stride, count);
+	case 8: return gather<8>(target, source, stride, count);
+	case 16: return gather<16>(target, source, stride, count);
+	}
+
+	for (std::size_t row = 0; row < count; ++row)
+		std::memcpy(target + row * width, source + row * stride, width);
+}
+} // namespace columnar
+} // namespace
+
+namespace cppx {
+
+ColumnStore::ColumnStore(const std::vector<std::size_t> &widths, const BufferManager *manager)
+    : m_widths(widths), m_columns(widths.size()), m_rowSize(0), m_rows(0), m_capacity(0), m_manager(manager)
+{
+	if (widths.empty())
+		throw Exception(Exception::makeCallString(__FUNCTION__, widths.size(), manager), colexc::no_columns);
+
+	if (!manager->flags.memory || !manager->flags.modify)
+		throw Exception(Exception::makeCallString(__FUNCTION__, widths.size(), manager), colexc::no_alloc);
+
+	for (const auto width : widths) {
+		if (!width)
+			throw Exception(Exception::makeCallString(__FUNCTION__, widths.size(), manager), colexc::zero_width);
+
+		m_rowSize += width;
+	}
+}
+
+std::size_t ColumnStore::columns() const noexcept
+{
+	return m_widths.size();
+}
+
+std::size_t ColumnStore::rows() const noexcept
+{
+	return m_rows;
+}
+
+std::size_t ColumnStore::capacity() const noexcept
+{
+	return m_capacity;
+}
+
+std::size_t ColumnStore::rowSize() const noexcept
+{
+	return m_rowSize;
+}
+
+std::size_t ColumnStore::width(std::size_t index) const
+{
+	if (index >= m_widths.size())
+		throw Exception(Exception::makeCallString(__FUNCTION__, index), colexc::invalid_column);
+
+	return m_widths[index];
+}
+
+Buffer ColumnStore::column(std::size_t index)
+{
+	if (index >= m_columns.size())
+		throw Exception(Exception::makeCallString(__FUNCTION__, index), colexc::invalid_column);
+
+	// the window is written through, so it must not reach a copy of the store
+	m_columns[index].selfDetach();
+
+	return Buffer::Stack(m_columns[index].data(), m_rows * m_widths[index]);
+}
+
+const Buffer ColumnStore::column(std::size_t index) const
+{
+	if (index >= m_columns.size())
+		throw Exception(Exception::makeCallString(__FUNCTION__, index), colexc::invalid_column);
+
+	return Buffer::Static(m_columns[index].data(), m_rows * m_widths[index]);
+}
+
+void ColumnStore::checkView(const char *function, std::size_t index, std::size_t size) const
+{
+	if (index >= m_widths.size())
+		throw Exception(Exception::makeCallString(function, index), colexc::invalid_column);
+
+	if (m_widths[index] != size)
+		throw Exception(Exception::makeCallString(function, index, size), colexc::width_mismatch);
+}
+
+[[nodiscard]] Buffer ColumnStore::row(std::size_t index, const BufferManager *manager) const
+{
+	if (index >= m_rows)
+		throw Exception(Exception::makeCallString(__FUNCTION__, index, manager), colexc::invalid_row);
+
+	auto result = Buffer(manager ? manager : m_manager, m_rowSize);
+	auto cursor = static_cast<std::uint8_t *>(result.data());
+
+	for (std::size_t i = 0; i < m_columns.size(); ++i) {
+		std::memcpy(cursor, static_cast<const std::uint8_t *>(m_columns[i].data()) + index * m_widths[i], m_widths[i]);
+		cursor += m_widths[i];
+	}
+
+	return result;
+}
+
+void ColumnStore::grow(std::size_t rows)
+{
+	if (rows <= m_capacity)
+		return;
+
+	std::size_t widest = 0;
+	for (const auto width : m_widths)
+		widest = width > widest ? width : widest;
+
+	const auto limit = BufferCore::max_size / widest;
+
+	if (rows > limit)
+		throw Exception(Exception::makeCallString(__FUNCTION__, rows), colexc::size_overflow);
+
+	// doubling keeps appends of single rows at amortized constant cost
+	auto capacity = m_capacity < columnar::min_capacity ? columnar::min_capacity : m_capacity * 2;
+	capacity = capacity < rows ? rows : capacity;
+	capacity = capacity > limit ? limit : capacity;
+
+	std::vector<Buffer> grown;
+	grown.reserve(m_columns.size());
+
+	// every column is allocated before any is replaced, so a failure leaves the store intact
+	for (std::size_t i = 0; i < m_columns.size(); ++i) {
+		grown.emplace_back(m_manager, capacity * m_widths[i]);
+
+		if (m_rows)
+			std::memcpy(grown.back().data(), m_columns[i].data(), m_rows * m_widths[i]);
+	}
+
+	m_columns.swap(grown);
+	m_capacity = capacity;
+}
+
+void ColumnStore::detach()
+{
+	for (auto &column : m_columns)
+		column.selfDetach();
+}
+
+ColumnStore &ColumnStore::selfReserve(std::size_t rows)
+{
+	grow(rows);
+	return *this;
+}
+
+ColumnStore &ColumnStore::selfAppendRows(const void *records, std::size_t count)
+{
+	if (!count)
+		return *this;
+
+	grow(m_rows + count);
+	detach();
+
+	// one column at a time, so every write stream is sequential
+	const auto source = static_cast<const std::uint8_t *>(records);
+	std::size_t offset = 0;
+
+	for (std::size_t i = 0; i < m_columns.size(); ++i) {
+		const auto width = m_widths[i];
+		const auto target = static_cast<std::uint8_t *>(m_columns[i].data()) + m_rows * width;
+
+		columnar::gather(target, source + offset, m_rowSize, count, width);
+
+		offset += width;
+	}
+
+	m_rows += count;
+
+	return *this;
+}
+
+ColumnStore &ColumnStore::selfAppendColumns(const std::vector<Buffer> &batch)
+{
+	if (batch.size() != m_columns.size())
+		throw Exception(Exception::makeCallString(__FUNCTION__, batch.size()), colexc::column_count_mismatch);
+
+	const auto count = batch[0].size() / m_widths[0];
+
+	for (std::size_t i = 0; i < batch.size(); ++i)
+		if (batch[i].size() != count * m_widths[i])
+			throw Exception(Exception::makeCallString(__FUNCTION__, batch.size(), i), colexc::row_count_mismatch);
+
+	if (!count)
+		return *this;
+
+	grow(m_rows + count);
+	detach();
+
+	for (std::size_t i = 0; i < m_columns.size(); ++i)
+		std::memcpy(static_cast<std::uint8_t *>(m_columns[i].data()) + m_rows * m_widths[i], batch[i].data(), batch[i].size());
+
+	m_rows += count;
+
+	return *this;
+}
+
+ColumnStore &ColumnStore::selfClear() noexcept
+{
+	m_rows = 0;
+	return *this;
+}
+
+} // namespace cppx
@@ -0,0 +1,495 @@
+#include "cppxCompress.hpp"
+#include "cppxException.hpp"
+
+#include <cstring>
+#include <vector>
+
+namespace {
+namespace lzexc {
+constexpr const char *no_manager = "No suitable data manager";
+constexpr const char *no_alloc = "Can't create buffer: manager has allocations disallowed";
+constexpr const char *size_overflow = "Size overflow";
+constexpr const char *corrupted = "Corrupted compressed data";
+} // namespace lzexc
+
+namespace lz {
+constexpr const std::uint32_t stored_flag = 0x80000000u;
+constexpr const std::size_t min_match = 4;
+constexpr const std::size_t hash_log = 12;
+//! @brief Matches are not searched for in the last bytes of a block; they are always emitted as literals
+constexpr const std::size_t match_limit = 12;
+constexpr const std::size_t last_literals = 5;
+
+inline std::uint32_t read32(const std::uint8_t *p)
+{
+	std::uint32_t v;
+	std::memcpy(&v, p, sizeof(v));
+	return v;
+}
+
+inline void writeLE32(std::uint8_t *p, std::uint32_t v)
+{
+	p[0] = std::uint8_t(v), p[1] = std::uint8_t(v >> 8), p[2] = std::uint8_t(v >> 16), p[3] = std::uint8_t(v >> 24);
+}
+
+inline std::uint32_t readLE32(const std::uint8_t *p)
+{
+	return std::uint32_t(p[0]) | std::uint32_t(p[1]) << 8 | std::uint32_t(p[2]) << 16 | std::uint32_t(p[3]) << 24;
+}
+
+inline std::uint32_t hash(std::uint32_t sequence)
+{
+	return (sequence * 2654435761u) >> (32 - hash_log);
+}
+
+inline std::size_t payloadBound(std::size_t size)
+{
+	return size + size / 255 + 16;
+}
+
+inline std::uint8_t *writeLength(std::uint8_t *op, std::size_t length)
+{
+	for (; length >= 255; length -= 255)
+		*op++ = 255;
+
+	*op++ = static_cast<std::uint8_t>(length);
+	return op;
+}
+
+inline std::uint8_t *writeSequence(std::uint8_t *op, const std::uint8_t *literals, std::size_t literalLength, std::size_t offset, std::size_t matchLength)
+{
+	std::uint8_t *const token = op++;
+	const std::size_t matchCode = matchLength ? matchLength - min_match : 0;
+
+	*token = static_cast<std::uint8_t>((literalLength < 15 ? literalLength : 15) << 4);
+	if (literalLength >= 15)
+		op = writeLength(op, literalLength - 15);
+
+	std::memcpy(op, literals, literalLength);
+	op += literalLength;
+
+	if (!matchLength)
+		return op;
+
+	*op++ = static_cast<std::uint8_t>(offset);
+	*op++ = static_cast<std::uint8_t>(offset >> 8);
+
+	*token |= static_cast<std::uint8_t>(matchCode < 15 ? matchCode : 15);
+	if (matchCode >= 15)
+		op = writeLength(op, matchCode - 15);
+
+	return op;
+}
+
+/**
+ * @brief Greedy single-probe LZ77 over one block of at most block_size bytes
+ * @returns the payload size written to |dst|, which must hold payloadBound(size) bytes
+ */
+std::size_t compressPayload(const std::uint8_t *src, std::size_t size, std::uint8_t *dst)
+{
+	std::uint8_t *op = dst;
+	std::size_t anchor = 0;
+
+	if (size > match_limit) {
+		std::uint32_t table[1 << hash_log];
+		std::memset(table, 0xFF, sizeof(table));
+
+		const std::size_t searchEnd = size - match_limit;
+		const std::size_t matchEnd = size - last_literals;
+
+		for (std::size_t ip = 0; ip <= searchEnd;) {
+			const auto sequence = read32(src + ip);
+			const auto h = hash(sequence);
+			const std::uint32_t candidate = table[h];
+			table[h] = static_cast<std::uint32_t>(ip);
+
+			if (candidate == 0xFFFFFFFFu || read32(src + candidate) != sequence) {
+				// skip faster through data that doesn't compress
+				ip += 1 + ((ip - anchor) >> 6);
+				continue;
+			}
+
+			std::size_t length = min_match;
+			while (ip + length < matchEnd && src[candidate + length] == src[ip + length])
+				++length;
+
+			op = writeSequence(op, src + anchor, ip - anchor, ip - candidate, length);
+
+			ip += length;
+			anchor = ip;
+
+			if (ip - 2 <= searchEnd)
+				table[hash(read32(src + ip - 2))] = static_cast<std::uint32_t>(ip - 2);
+		}
+	}
+
+	op = writeSequence(op, src + anchor, size - anchor, 0, 0);
+
+	return static_cast<std::size_t>(op - dst);
+}
+
+inline std::size_t readLength(const std::uint8_t *&ip, const std::uint8_t *const end)
+{
+	std::size_t length = 0;
+
+	for (;;) {
+		if (ip >= end)
+			throw cppx::Exception(__FUNCTION__, lzexc::corrupted);
+
+		const auto byte = *ip++;
+		length += byte;
+
+		if (byte != 255)
+			return length;
+	}
+}
+
+void decompressPayload(const std::uint8_t *ip, std::size_t size, std::uint8_t *dst, std::size_t capacity)
+{
+	const std::uint8_t *const iend = ip + size;
+	std::uint8_t *op = dst;
+	std::uint8_t *const oend = dst + capacity;
+
+	while (ip < iend) {
+		const auto token = *ip++;
+
+		std::size_t literalLength = token >> 4;
+		if (literalLength == 15)
+			literalLength += readLength(ip, iend);
+
+		if (std::size_t(iend - ip) < literalLength || std::size_t(oend - op) < literalLength)
+			throw cppx::Exception(__FUNCTION__, lzexc::corrupted);
+
+		std::memcpy(op, ip, literalLength);
+		ip += literalLength;
+		op += literalLength;
+
+		if (ip == iend)
+			break;
+
+		if (iend - ip < 2)
+			throw cppx::Exception(__FUNCTION__, lzexc::corrupted);
+
+		const std::size_t offset = std::size_t(ip[0]) | std::size_t(ip[1]) << 8;
+		ip += 2;
+
+		std::size_t matchLength = (token & 15) + min_match;
+		if ((token & 15) == 15)
+			matchLength += readLength(ip, iend);
+
+		if (offset == 0 || offset > std::size_t(op - dst) || std::size_t(oend - op) < matchLength)
+			throw cppx::Exception(__FUNCTION__, lzexc::corrupted);
+
+		const std::uint8_t *match = op - offset;
+
+		if (offset >= matchLength) {
+			std::memcpy(op, match, matchLength);
+			op += matchLength;
+		}
+		else {
+			// overlapping copy repeats the last |offset| bytes
+			for (std::size_t i = 0; i < matchLength; ++i)
+				*op++ = *match++;
+		}
+	}
+
+	if (op != oend)
+		throw cppx::Exception(__FUNCTION__, lzexc::corrupted);
+}
+
+//! @brief Writes a header and payload for |size| bytes; returns the number of bytes written
+std::size_t encodeBlock(const std::uint8_t *src, std::size_t size, std::uint8_t *dst)
+{
+	auto payloadSize = compressPayload(src, size, dst + cppx::Compression::header_size);
+	std::uint32_t flags = 0;
+
+	if (payloadSize >= size) {
+		std::memcpy(dst + cppx::Compression::header_size, src, size);
+		payloadSize = size;
+		flags = stored_flag;
+	}
+
+	writeLE32(dst, static_cast<std::uint32_t>(payloadSize) | flags);
+	writeLE32(dst + 4, static_cast<std::uint32_t>(size));
+
+	return cppx::Compression::header_size + payloadSize;
+}
+
+struct BlockInfo {
+	const std::uint8_t *payload;
+	std::size_t payloadSize;
+	std::size_t rawSize;
+	bool stored;
+};
+
+/**
+ * @brief Parses the header at |p|
+ * @returns false if fewer than a whole block's bytes are available
+ * @throw Exception if the header is invalid
+ */
+bool parseBlock(const std::uint8_t *p, std::size_t available, BlockInfo &info)
+{
+	if (available < cppx::Compression::header_size)
+		return false;
+
+	const auto word = readLE32(p);
+
+	info.payload = p + cppx::Compression::header_size;
+	info.payloadSize = word & ~stored_flag;
+	info.rawSize = readLE32(p + 4);
+	info.stored = (word & stored_flag) != 0;
+
+	if (info.rawSize > cppx::Compression::block_size ||
+	    info.payloadSize > payloadBound(cppx::Compression::block_size) ||
+	    (info.stored && info.payloadSize != info.rawSize))
+		throw cppx::Exception(__FUNCTION__, lzexc::corrupted);
+
+	return available - cppx::Compression::header_size >= info.payloadSize;
+}
+
+void decodeBlock(const BlockInfo &info, std::uint8_t *dst)
+{
+	if (info.stored)
+		std::memcpy(dst, info.payload, info.rawSize);
+	else
+		decompressPayload(info.payload, info.payloadSize, dst, info.rawSize);
+}
+
+const cppx::BufferManager *checkManager(const cppx::BufferManager *manager, const char *function)
+{
+	if (!manager)
+		throw cppx::Exception(function, lzexc::no_manager);
+
+	if (!(manager->flags.memory && manager->flags.modify))
+		throw cppx::Exception(function, lzexc::no_alloc);
+
+	return manager;
+}
+
+//! @brief Drops the unused tail of an output allocated for the worst case, in place on managers that reallocate
+inline void trim(cppx::Buffer &buffer, std::size_t used)
+{
+	if (used < buffer.size())
+		buffer.selfErase(used, buffer.size());
+}
+} // namespace lz
+} // namespace
+
+namespace cppx {
+#pragma region Compression
+
+/** @static */
+std::size_t Compression::bound(std::size_t size) noexcept
+{
+	const std::size_t blocks = size / block_size + ((size % block_size) ? 1 : 0);
+
+	return size + blocks * (header_size + lz::payloadBound(0)) + size / 255 + blocks;
+}
+
+/** @static */ [[nodiscard]] Buffer Compression::compress(const Buffer &source, const BufferManager *manager)
+{
+	const auto resultManager = lz::checkManager(manager ? manager : source.manager(), __FUNCTION__);
+
+	const auto size = source.size();
+	if (!size)
+		return Buffer(resultManager);
+
+	if (bound(size) > BufferCore::max_size)
+		throw Exception(Exception::makeCallString(__FUNCTION__, source, manager), lzexc::size_overflow);
+
+	auto result = Buffer(resultManager, bound(size));
+
+	const auto src = reinterpret_cast<const std::uint8_t *>(source.data());
+	const auto dst = reinterpret_cast<std::uint8_t *>(result.data());
+	std::size_t written = 0;
+
+	for (std::size_t offset = 0; offset < size; offset += block_size) {
+		const auto blockSize = size - offset < block_size ? size - offset : block_size;
+		written += lz::encodeBlock(src + offset, blockSize, dst + written);
+	}
+
+	lz::trim(result, written);
+
+	return result;
+}
+
+/** @static */ [[nodiscard]] Buffer Compression::decompress(const Buffer &source, const BufferManager *manager)
+{
+	const auto resultManager = lz::checkManager(manager ? manager : source.manager(), __FUNCTION__);
+
+	const auto src = reinterpret_cast<const std::uint8_t *>(source.data());
+	const auto size = source.size();
+
+	std::vector<lz::BlockInfo> blocks;
+	std::size_t total = 0;
+
+	for (std::size_t offset = 0; offset < size;) {
+		lz::BlockInfo info;
+
+		if (!lz::parseBlock(src + offset, size - offset, info))
+			throw Exception(Exception::makeCallString(__FUNCTION__, source, manager), lzexc::corrupted);
+
+		blocks.push_back(info);
+		total += info.rawSize;
+		offset += header_size + info.payloadSize;
+	}
+
+	if (total > BufferCore::max_size)
+		throw Exception(Exception::makeCallString(__FUNCTION__, source, manager), lzexc::size_overflow);
+
+	auto result = Buffer(resultManager, total);
+	auto dst = reinterpret_cast<std::uint8_t *>(result.data());
+
+	for (const auto &info : blocks) {
+		lz::decodeBlock(info, dst);
+		dst += info.rawSize;
+	}
+
+	return result;
+}
+
+// Compression
+#pragma endregion
+#pragma region CompressStream
+
+CompressStream::CompressStream(const BufferManager *manager)
+    : m_manager(lz::checkManager(manager, __FUNCTION__)),
+      m_pending(Buffer::HeapPreall(Compression::block_size))
+{
+}
+
+[[nodiscard]] Buffer CompressStream::write(const Buffer &chunk)
+{
+	auto src = reinterpret_cast<std::uint8_t *>(chunk.data());
+	auto size = chunk.size();
+
+	const auto blocks = (m_pending.size() + size) / Compression::block_size;
+
+	if (!blocks) {
+		m_pending.selfAppend(Buffer::Stack(src, size));
+		return Buffer(m_manager);
+	}
+
+	auto result = Buffer(m_manager, blocks * (Compression::header_size + lz::payloadBound(Compression::block_size)));
+	auto dst = reinterpret_cast<std::uint8_t *>(result.data());
+	std::size_t written = 0;
+
+	if (m_pending.size()) {
+		const auto fill = Compression::block_size - m_pending.size();
+
+		// completes the carried-over block inside its preallocated tail
+		m_pending.selfAppend(Buffer::Stack(src, fill));
+		written += lz::encodeBlock(reinterpret_cast<const std::uint8_t *>(m_pending.data()), Compression::block_size, dst);
+		m_pending.selfErase(0, m_pending.size());
+
+		src += fill;
+		size -= fill;
+	}
+
+	for (; size >= Compression::block_size; src += Compression::block_size, size -= Compression::block_size)
+		written += lz::encodeBlock(src, Compression::block_size, dst + written);
+
+	if (size)
+		m_pending.selfAppend(Buffer::Stack(src, size));
+
+	lz::trim(result, written);
+
+	return result;
+}
+
+[[nodiscard]] Buffer CompressStream::flush()
+{
+	if (!m_pending.size())
+		return Buffer(m_manager);
+
+	auto result = Buffer(m_manager, Compression::header_size + lz::payloadBound(m_pending.size()));
+	const auto written = lz::encodeBlock(
+	    reinterpret_cast<const std::uint8_t *>(m_pending.data()),
+	    m_pending.size(),
+	    reinterpret_cast<std::uint8_t *>(result.data()));
+
+	m_pending.selfErase(0, m_pending.size());
+	lz::trim(result, written);
+
+	return result;
+}
+
+// CompressStream
+#pragma endregion
+#pragma region DecompressStream
+
+DecompressStream::DecompressStream(const BufferManager *manager)
+    : m_manager(lz::checkManager(manager, __FUNCTION__)),
+      m_pending(Buffer::onHeap)
+{
+}
+
+[[nodiscard]] Buffer DecompressStream::write(const Buffer &chunk)
+{
+	auto src = reinterpret_cast<std::uint8_t *>(chunk.data());
+	auto size = chunk.size();
+
+	std::vector<lz::BlockInfo> blocks;
+	std::size_t total = 0;
+	lz::BlockInfo info;
+	bool carried = false;
+
+	// completes the block carried over from the previous chunk first
+	if (m_pending.size()) {
+		if (m_pending.size() < Compression::header_size) {
+			const auto take = Compression::header_size - m_pending.size() < size ? Compression::header_size - m_pending.size() : size;
+
+			m_pending.selfAppend(Buffer::Stack(src, take));
+			src += take, size -= take;
+		}
+
+		if (m_pending.size() >= Compression::header_size) {
+			lz::parseBlock(reinterpret_cast<const std::uint8_t *>(m_pending.data()), m_pending.size(), info);
+
+			const auto missing = Compression::header_size + info.payloadSize - m_pending.size();
+			const auto take = missing < size ? missing : size;
+
+			m_pending.selfAppend(Buffer::Stack(src, take));
+			src += take, size -= take;
+
+			if (lz::parseBlock(reinterpret_cast<const std::uint8_t *>(m_pending.data()), m_pending.size(), info)) {
+				blocks.push_back(info);
+				total += info.rawSize;
+				carried = true;
+			}
+		}
+	}
+
+	while (size && lz::parseBlock(src, size, info)) {
+		blocks.push_back(info);
+		total += info.rawSize;
+
+		src += Compression::header_size + info.payloadSize;
+		size -= Compression::header_size + info.payloadSize;
+	}
+
+	auto result = Buffer(m_manager, total);
+	auto dst = reinterpret_cast<std::uint8_t *>(result.data());
+
+	for (const auto &block : blocks) {
+		lz::decodeBlock(block, dst);
+		dst += block.rawSize;
+	}
+
+	if (carried)
+		m_pending.selfErase(0, m_pending.size());
+
+	if (size)
+		m_pending.selfAppend(Buffer::Stack(src, size));
+
+	return result;
+}
+
+bool DecompressStream::pending() const noexcept
+{
+	return m_pending.size() != 0;
+}
+
+// DecompressStream
+#pragma endregion
+} // namespace cppx
@@ -0,0 +1,187 @@
+#include "cppxHash.hpp"
+
+#include <cstring>
+
+namespace {
+namespace xxh64 {
+constexpr const std::uint64_t prime1 = 0x9E3779B185EBCA87ull;
+constexpr const std::uint64_t prime2 = 0xC2B2AE3D27D4EB4Full;
+constexpr const std::uint64_t prime3 = 0x165667B19E3779F9ull;
+constexpr const std::uint64_t prime4 = 0x85EBCA77C2B2AE63ull;
+constexpr const std::uint64_t prime5 = 0x27D4EB2F165667C5ull;
+
+inline std::uint64_t rotl(std::uint64_t x, int r)
+{
+	return (x << r) | (x >> (64 - r));
+}
+
+inline std::uint64_t read64(const std::uint8_t *p)
+{
+	std::uint64_t v;
+	std::memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	v = __builtin_bswap64(v);
+#endif
+	return v;
+}
+
+inline std::uint32_t read32(const std::uint8_t *p)
+{
+	std::uint32_t v;
+	std::memcpy(&v, p, sizeof(v));
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+	v = __builtin_bswap32(v);
+#endif
+	return v;
+}
+
+inline std::uint64_t round(std::uint64_t acc, std::uint64_t input)
+{
+	acc += input * prime2;
+	acc = rotl(acc, 31);
+	return acc * prime1;
+}
+
+inline std::uint64_t mergeRound(std::uint64_t acc, std::uint64_t value)
+{
+	acc ^= round(0, value);
+	return acc * prime1 + prime4;
+}
+
+//! @brief Consumes whole 32-byte stripes; the four independent lanes keep the loop pipelined
+inline const std::uint8_t *consumeStripes(std::uint64_t (&lanes)[4], const std::uint8_t *p, const std::uint8_t *const end)
+{
+	std::uint64_t v1 = lanes[0], v2 = lanes[1], v3 = lanes[2], v4 = lanes[3];
+
+	for (; end - p >= 32; p += 32) {
+		v1 = round(v1, read64(p));
+		v2 = round(v2, read64(p + 8));
+		v3 = round(v3, read64(p + 16));
+		v4 = round(v4, read64(p + 24));
+	}
+
+	lanes[0] = v1, lanes[1] = v2, lanes[2] = v3, lanes[3] = v4;
+	return p;
+}
+} // namespace xxh64
+} // namespace
+
+namespace cppx {
+
+Hasher::Hasher(std::uint64_t seed) noexcept
+{
+	reset(seed);
+}
+
+Hasher &Hasher::reset(std::uint64_t seed) noexcept
+{
+	m_seed = seed;
+	m_total = 0;
+	m_pendingSize = 0;
+
+	m_lanes[0] = seed + xxh64::prime1 + xxh64::prime2;
+	m_lanes[1] = seed + xxh64::prime2;
+	m_lanes[2] = seed;
+	m_lanes[3] = seed - xxh64::prime1;
+
+	return *this;
+}
+
+Hasher &Hasher::update(const void *data, std::size_t size) noexcept
+{
+	if (!data || !size)
+		return *this;
+
+	auto p = reinterpret_cast<const std::uint8_t *>(data);
+	const auto end = p + size;
+
+	m_total += size;
+
+	if (m_pendingSize + size < stripe_size) {
+		std::memcpy(m_pending + m_pendingSize, p, size);
+		m_pendingSize += static_cast<std::uint32_t>(size);
+		return *this;
+	}
+
+	if (m_pendingSize) {
+		const auto fill = stripe_size - m_pendingSize;
+		std::memcpy(m_pending + m_pendingSize, p, fill);
+		xxh64::consumeStripes(m_lanes, m_pending, m_pending + stripe_size);
+
+		p += fill;
+		m_pendingSize = 0;
+	}
+
+	p = xxh64::consumeStripes(m_lanes, p, end);
+
+	if (p < end) {
+		m_pendingSize = static_cast<std::uint32_t>(end - p);
+		std::memcpy(m_pending, p, m_pendingSize);
+	}
+
+	return *this;
+}
+
+Hasher &Hasher::update(const Buffer &buffer) noexcept
+{
+	return update(buffer.data(), buffer.size());
+}
+
+std::uint64_t Hasher::digest() const noexcept
+{
+	std::uint64_t h;
+
+	if (m_total >= stripe_size) {
+		h = xxh64::rotl(m_lanes[0], 1) + xxh64::rotl(m_lanes[1], 7) +
+		    xxh64::rotl(m_lanes[2], 12) + xxh64::rotl(m_lanes[3], 18);
+
+		for (const auto lane : m_lanes)
+			h = xxh64::mergeRound(h, lane);
+	}
+	else {
+		h = m_seed + xxh64::prime5;
+	}
+
+	h += m_total;
+
+	const std::uint8_t *p = m_pending;
+	const std::uint8_t *const end = m_pending + m_pendingSize;
+
+	for (; end - p >= 8; p += 8) {
+		h ^= xxh64::round(0, xxh64::read64(p));
+		h = xxh64::rotl(h, 27) * xxh64::prime1 + xxh64::prime4;
+	}
+
+	if (end - p >= 4) {
+		h ^= std::uint64_t(xxh64::read32(p)) * xxh64::prime1;
+		h = xxh64::rotl(h, 23) * xxh64::prime2 + xxh64::prime3;
+		p += 4;
+	}
+
+	for (; p < end; ++p) {
+		h ^= (*p) * xxh64::prime5;
+		h = xxh64::rotl(h, 11) * xxh64::prime1;
+	}
+
+	h ^= h >> 33;
+	h *= xxh64::prime2;
+	h ^= h >> 29;
+	h *= xxh64::prime3;
+	h ^= h >> 32;
+
+	return h;
+}
+
+/** @static */
+std::uint64_t Hasher::hash(const void *data, std::size_t size, std::uint64_t seed) noexcept
+{
+	return Hasher(seed).update(data, size).digest();
+}
+
+/** @static */
+std::uint64_t Hasher::hash(const Buffer &buffer, std::uint64_t seed) noexcept
+{
+	return hash(buffer.data(), buffer.size(), seed);
+}
+
+} // namespace cppx
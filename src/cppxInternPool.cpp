@@ -0,0 +1,164 @@
+#include "cppxInternPool.hpp"
+#include "cppxException.hpp"
+#include "cppxHash.hpp"
+
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace {
+namespace internexc {
+constexpr const char *no_shards = "A pool needs at least one shard";
+constexpr const char *no_alloc = "Can't create pool: manager has allocations disallowed";
+} // namespace internexc
+
+namespace interning {
+constexpr const std::size_t min_sweep = 64;
+
+inline bool sameContents(const cppx::Buffer &left, const cppx::Buffer &right)
+{
+	return left.size() == right.size() && !std::memcmp(left.data(), right.data(), left.size());
+}
+} // namespace interning
+} // namespace
+
+namespace cppx {
+
+struct InternPool::Shard {
+	mutable std::mutex mutex;
+
+	//! @brief Keyed by content hash; equal hashes are told apart by comparing contents
+	std::unordered_multimap<std::uint64_t, Buffer> entries;
+
+	//! @brief Entry count at which intern() sweeps the shard next
+	std::size_t sweepAt = interning::min_sweep;
+
+	//! @brief Evicts the unshared entries; the caller holds the lock
+	std::size_t sweep()
+	{
+		std::size_t evicted = 0;
+
+		for (auto it = entries.begin(); it != entries.end();) {
+			if (it->second.shared()) {
+				++it;
+				continue;
+			}
+
+			it = entries.erase(it);
+			++evicted;
+		}
+
+		sweepAt = entries.size() * 2 > interning::min_sweep ? entries.size() * 2 : interning::min_sweep;
+
+		return evicted;
+	}
+};
+
+InternPool::InternPool(std::size_t shards, const BufferManager *manager)
+    : m_shardCount(shards), m_manager(manager)
+{
+	if (!shards)
+		throw Exception(Exception::makeCallString(__FUNCTION__, shards, manager), internexc::no_shards);
+
+	if (!manager->flags.memory)
+		throw Exception(Exception::makeCallString(__FUNCTION__, shards, manager), internexc::no_alloc);
+
+	m_shards.reset(new Shard[shards]);
+}
+
+InternPool::~InternPool() = default;
+
+InternPool::Shard &InternPool::shardOf(std::uint64_t hash) const noexcept
+{
+	// the high bits, since the maps bucket by the low ones
+	return m_shards[(hash >> 40) % m_shardCount];
+}
+
+[[nodiscard]] Buffer InternPool::intern(const Buffer &buffer)
+{
+	if (!buffer.size())
+		return Buffer();
+
+	const auto hash = Hasher::hash(buffer);
+	auto &shard = shardOf(hash);
+
+	std::lock_guard<std::mutex> lock(shard.mutex);
+
+	const auto range = shard.entries.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it)
+		if (interning::sameContents(it->second, buffer))
+			return it->second;
+
+	if (shard.entries.size() >= shard.sweepAt)
+		shard.sweep();
+
+	return shard.entries.emplace(hash, buffer.clone(m_manager))->second;
+}
+
+bool InternPool::contains(const Buffer &buffer) const
+{
+	if (!buffer.size())
+		return false;
+
+	const auto hash = Hasher::hash(buffer);
+	auto &shard = shardOf(hash);
+
+	std::lock_guard<std::mutex> lock(shard.mutex);
+
+	const auto range = shard.entries.equal_range(hash);
+	for (auto it = range.first; it != range.second; ++it)
+		if (interning::sameContents(it->second, buffer))
+			return true;
+
+	return false;
+}
+
+std::size_t InternPool::size() const
+{
+	std::size_t result = 0;
+
+	for (std::size_t i = 0; i < m_shardCount; ++i) {
+		std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+		result += m_shards[i].entries.size();
+	}
+
+	return result;
+}
+
+std::size_t InternPool::bytes() const
+{
+	std::size_t result = 0;
+
+	for (std::size_t i = 0; i < m_shardCount; ++i) {
+		std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+
+		for (const auto &entry : m_shards[i].entries)
+			result += entry.second.size();
+	}
+
+	return result;
+}
+
+std::size_t InternPool::sweep()
+{
+	std::size_t result = 0;
+
+	for (std::size_t i = 0; i < m_shardCount; ++i) {
+		std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+		result += m_shards[i].sweep();
+	}
+
+	return result;
+}
+
+void InternPool::clear()
+{
+	for (std::size_t i = 0; i < m_shardCount; ++i) {
+		std::lock_guard<std::mutex> lock(m_shards[i].mutex);
+
+		m_shards[i].entries.clear();
+		m_shards[i].sweepAt = interning::min_sweep;
+	}
+}
+
+} // namespace cppx
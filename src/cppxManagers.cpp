@@ -0,0 +1,285 @@
+#include "cppxManagers.hpp"
+#include "cppxException.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <string>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace {
+namespace mgrexc {
+constexpr const char *unsupported_alignment = "Unsupported alignment";
+} // namespace mgrexc
+
+namespace aligning {
+inline std::size_t roundUp(std::size_t size, std::size_t alignment)
+{
+	return (size + alignment - 1) / alignment * alignment;
+}
+
+//! @brief |granule| is the multiple the length of every block is rounded up to
+inline void *allocate(std::size_t size, std::size_t alignment, std::size_t granule)
+{
+	return std::aligned_alloc(alignment, roundUp(size ? size : 1, granule));
+}
+
+void *reallocate(void *address, std::size_t oldSize, std::size_t newSize, std::size_t alignment, std::size_t granule)
+{
+	if (roundUp(oldSize ? oldSize : 1, granule) == roundUp(newSize ? newSize : 1, granule))
+		return address;
+
+	// malloc alignment is enough for realloc to keep it
+	if (alignment <= alignof(std::max_align_t))
+		return std::realloc(address, roundUp(newSize ? newSize : 1, granule));
+
+	const auto result = allocate(newSize, alignment, granule);
+
+	if (result) {
+		std::memcpy(result, address, oldSize < newSize ? oldSize : newSize);
+		std::free(address);
+	}
+
+	return result;
+}
+
+cppx::BufferManager makeManager(const char *name, std::size_t alignment, std::size_t granule)
+{
+	return {
+	    name,
+	    {1, 1, 0},
+	    [alignment, granule](std::size_t size) -> void * { return allocate(size, alignment, granule); },
+	    [](void *ptr, std::size_t) -> void { std::free(ptr); },
+	    [alignment, granule](void *ptr, std::size_t oldSize, std::size_t newSize) -> void * { return reallocate(ptr, oldSize, newSize, alignment, granule); }};
+}
+} // namespace aligning
+
+namespace pages {
+constexpr const std::size_t huge = cppx::Managers::huge_page_size;
+
+// from <numaif.h>, which needs libnuma
+constexpr const int mpol_bind = 2;
+constexpr const int mpol_interleave = 3;
+
+//! @brief Placement of the large blocks; node is ignored unless policy is mpol_bind
+struct Placement {
+	int policy;
+	std::size_t node;
+};
+
+inline std::size_t mappedSize(std::size_t size)
+{
+	return (size + huge - 1) / huge * huge;
+}
+
+inline bool isMapped(std::size_t size)
+{
+	return size >= huge;
+}
+
+#if defined(__linux__)
+void place(void *address, std::size_t length, const Placement &placement)
+{
+	const auto nodes = cppx::Managers::numaNodes();
+
+	if (!placement.policy || nodes <= 1 || (placement.policy == mpol_bind && placement.node >= nodes))
+		return;
+
+	constexpr const std::size_t bits = sizeof(unsigned long) * 8;
+	unsigned long mask[16] = {};
+
+	if (placement.policy == mpol_bind)
+		mask[placement.node / bits] = 1ul << (placement.node % bits);
+	else
+		for (std::size_t node = 0; node < nodes && node < sizeof(mask) * 8; ++node)
+			mask[node / bits] |= 1ul << (node % bits);
+
+	// the pages are placed by the first touch either way, so failures are ignored
+	syscall(SYS_mbind, address, length, placement.policy, mask, sizeof(mask) * 8, 0);
+}
+
+void *map(std::size_t size, const Placement &placement)
+{
+	const auto length = mappedSize(size);
+	const auto address = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+	if (address == MAP_FAILED)
+		return nullptr;
+
+#if defined(MADV_HUGEPAGE)
+	madvise(address, length, MADV_HUGEPAGE);
+#endif
+
+	place(address, length, placement);
+
+	return address;
+}
+
+void unmap(void *address, std::size_t size)
+{
+	munmap(address, mappedSize(size));
+}
+
+void *remap(void *address, std::size_t oldSize, std::size_t newSize, const Placement &placement)
+{
+	const auto oldLength = mappedSize(oldSize), newLength = mappedSize(newSize);
+
+	if (oldLength == newLength)
+		return address;
+
+	const auto result = mremap(address, oldLength, newLength, MREMAP_MAYMOVE);
+
+	if (result == MAP_FAILED)
+		return nullptr;
+
+	if (newLength > oldLength) {
+#if defined(MADV_HUGEPAGE)
+		madvise(result, newLength, MADV_HUGEPAGE);
+#endif
+		place(result, newLength, placement);
+	}
+
+	return result;
+}
+#else  // defined(__linux__)
+void *map(std::size_t size, const Placement &)
+{
+	return std::malloc(size);
+}
+
+void unmap(void *address, std::size_t)
+{
+	std::free(address);
+}
+
+void *remap(void *address, std::size_t, std::size_t newSize, const Placement &)
+{
+	return std::realloc(address, newSize);
+}
+#endif // defined(__linux__)
+
+void *allocate(std::size_t size, const Placement &placement)
+{
+	return isMapped(size) ? map(size, placement) : std::malloc(size ? size : 1);
+}
+
+//! @brief Fresh mappings are zero pages already, so only the small blocks need calloc
+void *allocateZeroed(std::size_t size, const Placement &placement)
+{
+#if defined(__linux__)
+	if (isMapped(size))
+		return map(size, placement);
+#endif // defined(__linux__)
+
+	return std::calloc(size ? size : 1, 1);
+}
+
+void release(void *address, std::size_t size)
+{
+	if (isMapped(size))
+		unmap(address, size);
+	else
+		std::free(address);
+}
+
+void *reallocate(void *address, std::size_t oldSize, std::size_t newSize, const Placement &placement)
+{
+	if (isMapped(oldSize) && isMapped(newSize))
+		return remap(address, oldSize, newSize, placement);
+
+	if (!isMapped(oldSize) && !isMapped(newSize))
+		return std::realloc(address, newSize ? newSize : 1);
+
+	// crossing the threshold moves the block between malloc and mmap
+	const auto result = allocate(newSize, placement);
+
+	if (result) {
+		std::memcpy(result, address, oldSize < newSize ? oldSize : newSize);
+		release(address, oldSize);
+	}
+
+	return result;
+}
+
+cppx::BufferManager makeManager(const char *name, const Placement &placement)
+{
+	return {
+	    name,
+	    {1, 1, 0},
+	    [placement](std::size_t size) -> void * { return allocate(size, placement); },
+	    [](void *ptr, std::size_t size) -> void { release(ptr, size); },
+	    [placement](void *ptr, std::size_t oldSize, std::size_t newSize) -> void * { return reallocate(ptr, oldSize, newSize, placement); },
+	    [placement](std::size_t size) -> void * { return allocateZeroed(size, placement); }};
+}
+} // namespace pages
+} // namespace
+
+namespace cppx {
+
+/** @static */
+const BufferManager Managers::aligned16Manager = aligning::makeManager("aligned16Manager", 16, 16);
+
+/** @static */
+const BufferManager Managers::aligned32Manager = aligning::makeManager("aligned32Manager", 32, 32);
+
+/** @static */
+const BufferManager Managers::aligned64Manager = aligning::makeManager("aligned64Manager", 64, 64);
+
+/** @static */
+const BufferManager Managers::aligned4096Manager = aligning::makeManager("aligned4096Manager", 4096, 4096);
+
+/** @static */
+const BufferManager Managers::directManager = aligning::makeManager("directManager", page_size, page_size);
+
+/** @static */
+const BufferManager Managers::hugePageManager = pages::makeManager("hugePageManager", {0, 0});
+
+/** @static */
+const BufferManager Managers::interleavedManager = pages::makeManager("interleavedManager", {pages::mpol_interleave, 0});
+
+/** @static */
+const BufferManager *Managers::aligned(std::size_t alignment)
+{
+	switch (alignment) {
+	case 16: return onAligned16;
+	case 32: return onAligned32;
+	case 64: return onAligned64;
+	case 4096: return onAligned4096;
+	}
+
+	throw Exception(Exception::makeCallString(__FUNCTION__, alignment), mgrexc::unsupported_alignment);
+}
+
+/** @static */
+std::size_t Managers::numaNodes() noexcept
+{
+	// "0", "0-1", or a list like "0,2-3"; the highest node decides
+	static const std::size_t nodes = []() -> std::size_t {
+		std::ifstream online("/sys/devices/system/node/online");
+		std::string list;
+
+		if (!(online >> list) || list.empty())
+			return 1;
+
+		const auto last = list.find_last_of(",-");
+		const auto highest = std::strtoul(list.c_str() + (last == std::string::npos ? 0 : last + 1), nullptr, 10);
+
+		return highest + 1;
+	}();
+
+	return nodes;
+}
+
+/** @static */
+[[nodiscard]] BufferManager Managers::nodeManager(std::size_t node)
+{
+	return pages::makeManager("nodeManager", {pages::mpol_bind, node});
+}
+
+} // namespace cppx
@@ -0,0 +1,81 @@
+#include "cppxParallel.hpp"
+
+#include <atomic>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+namespace {
+namespace parallel {
+//! @brief Joins the started threads however forEachChunk returns
+struct Joiner {
+	std::vector<std::thread> &threads;
+
+	~Joiner()
+	{
+		for (auto &thread : threads)
+			thread.join();
+	}
+};
+} // namespace parallel
+} // namespace
+
+namespace cppx {
+
+std::size_t Parallel::concurrency() const noexcept
+{
+	if (threads)
+		return threads;
+
+	const auto hardware = std::thread::hardware_concurrency();
+	return hardware ? hardware : 1;
+}
+
+void Parallel::forEachChunk(std::size_t size, const std::function<void(std::size_t, std::size_t)> &task) const
+{
+	const std::size_t step = chunk ? chunk : default_chunk;
+	const std::size_t chunks = size / step + ((size % step) ? 1 : 0);
+	const std::size_t workers = concurrency() < chunks ? concurrency() : chunks;
+
+	if (workers <= 1) {
+		if (size)
+			task(0, size);
+
+		return;
+	}
+
+	std::atomic<std::size_t> next(0);
+
+	const auto work = [&]() {
+		for (std::size_t i = next++; i < chunks; i = next++) {
+			const auto begin = i * step;
+			task(begin, begin + step < size ? begin + step : size);
+		}
+	};
+
+	std::vector<std::thread> pool;
+	pool.reserve(workers - 1);
+
+	const parallel::Joiner joiner{pool};
+
+	for (std::size_t i = 1; i < workers; ++i) {
+		try {
+			pool.emplace_back(work);
+		}
+		catch (const std::system_error &) {
+			// out of threads; the ones running, this one included, take the remaining chunks
+			break;
+		}
+	}
+
+	try {
+		work();
+	}
+	catch (...) {
+		// the other threads stop after their current chunk
+		next = chunks;
+		throw;
+	}
+}
+
+} // namespace cppx
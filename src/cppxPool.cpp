@@ -0,0 +1,326 @@
+#include "cppxPool.hpp"
+#include "cppxException.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <mutex>
+#include <vector>
+
+namespace {
+namespace poolexc {
+constexpr const char *bad_block = "A pool's block size must be between 1 and BufferCore::max_preall";
+constexpr const char *no_cache = "A pool needs room for at least one block per thread";
+} // namespace poolexc
+} // namespace
+
+namespace cppx {
+
+#pragma region BufferPool::Shared
+
+//! @brief The state of a pool, kept alive by its threads' caches until they are gone too
+struct BufferPool::Shared : std::enable_shared_from_this<Shared> {
+	struct Cache {
+		std::shared_ptr<Shared> pool;
+		std::vector<void *> blocks;
+
+		//! @brief Freed BufferCores of the pool's buffers, reused by the next acquire() on the thread
+		std::vector<void *> cores;
+	};
+
+	//! @brief The caches of a thread, one per pool it used; handed back when the thread exits
+	struct Caches {
+		std::vector<Cache> entries;
+		~Caches();
+	};
+
+	static thread_local Caches s_caches;
+
+	//! @brief Set once s_caches is destroyed; buffers released after that bypass the thread's cache
+	static thread_local bool s_exited;
+
+	const std::size_t blockSize;
+	const std::size_t threadCache;
+	const std::size_t overflowLimit;
+
+	std::atomic<std::size_t> allocations{0};
+	std::atomic<bool> alive{true};
+
+	std::mutex mutex;
+	std::vector<void *> overflow;
+
+	Shared(std::size_t size, const PoolOptions &options)
+	    : blockSize(size), threadCache(options.threadCache), overflowLimit(options.overflow)
+	{
+	}
+
+	~Shared()
+	{
+		for (const auto block : overflow)
+			std::free(block);
+	}
+
+	//! @brief The calling thread's cache of this pool, created on first use; nullptr while the thread exits
+	Cache *localCache()
+	{
+		if (s_exited)
+			return nullptr;
+
+		auto &entries = s_caches.entries;
+
+		for (auto &entry : entries)
+			if (entry.pool.get() == this)
+				return &entry;
+
+		// caches of pools destroyed since the thread last missed are dropped here
+		entries.erase(std::remove_if(entries.begin(), entries.end(), [](Cache &entry) {
+			              if (entry.pool->alive.load(std::memory_order_relaxed))
+				              return false;
+
+			              for (const auto block : entry.blocks)
+				              std::free(block);
+
+			              for (const auto core : entry.cores)
+				              std::free(core);
+
+			              return true;
+		              }),
+		    entries.end());
+
+		entries.push_back({shared_from_this(), {}, {}});
+		entries.back().blocks.reserve(threadCache + 1);
+		entries.back().cores.reserve(threadCache);
+
+		return &entries.back();
+	}
+
+	void *take(std::size_t size)
+	{
+		if (size != blockSize)
+			return std::malloc(size ? size : 1);
+
+		const auto cache = localCache();
+
+		if (cache && !cache->blocks.empty()) {
+			const auto block = cache->blocks.back();
+			cache->blocks.pop_back();
+			return block;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			if (!overflow.empty()) {
+				if (cache) {
+					// half a cache at a time, so the next misses don't take the lock again
+					const auto moved = std::min(overflow.size(), (threadCache + 1) / 2);
+
+					cache->blocks.insert(cache->blocks.end(), overflow.end() - moved, overflow.end());
+					overflow.resize(overflow.size() - moved);
+				}
+				else {
+					const auto block = overflow.back();
+					overflow.pop_back();
+					return block;
+				}
+			}
+		}
+
+		if (cache && !cache->blocks.empty()) {
+			const auto block = cache->blocks.back();
+			cache->blocks.pop_back();
+			return block;
+		}
+
+		allocations.fetch_add(1, std::memory_order_relaxed);
+		return std::malloc(blockSize);
+	}
+
+	void give(void *block, std::size_t size)
+	{
+		if (!block)
+			return;
+
+		if (size != blockSize) {
+			std::free(block);
+			return;
+		}
+
+		const auto cache = localCache();
+
+		if (!cache) {
+			std::vector<void *> single(1, block);
+			spill(single, 1);
+			return;
+		}
+
+		cache->blocks.push_back(block);
+
+		if (cache->blocks.size() > threadCache)
+			spill(cache->blocks, cache->blocks.size() / 2);
+	}
+
+	void *takeCore(std::size_t size)
+	{
+		const auto cache = localCache();
+
+		if (cache && !cache->cores.empty()) {
+			const auto core = cache->cores.back();
+			cache->cores.pop_back();
+			return core;
+		}
+
+		return std::malloc(size);
+	}
+
+	//! @brief Keeps |core| for the thread's next acquire(); cores beyond the thread's cache are freed
+	void giveCore(void *core, std::size_t)
+	{
+		const auto cache = localCache();
+
+		if (cache && cache->cores.size() < threadCache)
+			cache->cores.push_back(core);
+		else
+			std::free(core);
+	}
+
+	//! @brief Moves the last |count| of |blocks| to the overflow list, freeing those that don't fit
+	void spill(std::vector<void *> &blocks, std::size_t count)
+	{
+		auto from = blocks.end() - static_cast<std::ptrdiff_t>(count);
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			if (alive.load(std::memory_order_relaxed)) {
+				const auto room = overflowLimit > overflow.size() ? overflowLimit - overflow.size() : 0;
+				const auto kept = static_cast<std::ptrdiff_t>(std::min(room, count));
+
+				overflow.insert(overflow.end(), from, from + kept);
+				from += kept;
+			}
+		}
+
+		for (auto block = from; block != blocks.end(); ++block)
+			std::free(*block);
+
+		blocks.resize(blocks.size() - count);
+	}
+
+	//! @brief Frees the overflow list and the calling thread's cache of this pool
+	std::size_t trim()
+	{
+		std::vector<void *> freed;
+
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			freed.swap(overflow);
+		}
+
+		if (!s_exited)
+			for (auto &entry : s_caches.entries)
+				if (entry.pool.get() == this) {
+					freed.insert(freed.end(), entry.blocks.begin(), entry.blocks.end());
+					entry.blocks.clear();
+
+					for (const auto core : entry.cores)
+						std::free(core);
+
+					entry.cores.clear();
+				}
+
+		for (const auto block : freed)
+			std::free(block);
+
+		return freed.size();
+	}
+};
+
+/** @static */
+thread_local BufferPool::Shared::Caches BufferPool::Shared::s_caches;
+
+/** @static */
+thread_local bool BufferPool::Shared::s_exited = false;
+
+BufferPool::Shared::Caches::~Caches()
+{
+	s_exited = true;
+
+	for (auto &entry : entries) {
+		entry.pool->spill(entry.blocks, entry.blocks.size());
+
+		for (const auto core : entry.cores)
+			std::free(core);
+	}
+}
+
+// BufferPool::Shared
+#pragma endregion
+
+#pragma region BufferPool
+
+BufferPool::BufferPool(std::size_t blockSize, const PoolOptions &options)
+    : m_shared(std::make_shared<Shared>(blockSize, options)),
+      m_manager{
+          "poolManager",
+          {1, 1, 0},
+          [shared = m_shared.get()](std::size_t size) -> void * { return shared->take(size); },
+          [shared = m_shared.get()](void *ptr, std::size_t size) -> void { shared->give(ptr, size); },
+          nullptr,
+          nullptr,
+          [shared = m_shared.get()](std::size_t size) -> void * { return shared->takeCore(size); },
+          [shared = m_shared.get()](void *ptr, std::size_t size) -> void { shared->giveCore(ptr, size); }}
+{
+	if (!blockSize || blockSize > BufferCore::max_preall)
+		throw Exception(Exception::makeCallString(__FUNCTION__, blockSize), poolexc::bad_block);
+
+	if (!options.threadCache)
+		throw Exception(Exception::makeCallString(__FUNCTION__, blockSize), poolexc::no_cache);
+}
+
+BufferPool::~BufferPool()
+{
+	{
+		// threads spilling later free their blocks; those that spilled before have them freed by trim()
+		std::lock_guard<std::mutex> lock(m_shared->mutex);
+		m_shared->alive.store(false, std::memory_order_relaxed);
+	}
+
+	m_shared->trim();
+}
+
+const BufferManager *BufferPool::manager() const noexcept
+{
+	return &m_manager;
+}
+
+std::size_t BufferPool::blockSize() const noexcept
+{
+	return m_shared->blockSize;
+}
+
+[[nodiscard]] Buffer BufferPool::acquire()
+{
+	return Buffer::Preall(&m_manager, m_shared->blockSize);
+}
+
+std::size_t BufferPool::allocations() const noexcept
+{
+	return m_shared->allocations.load(std::memory_order_relaxed);
+}
+
+std::size_t BufferPool::overflowSize() const
+{
+	std::lock_guard<std::mutex> lock(m_shared->mutex);
+	return m_shared->overflow.size();
+}
+
+std::size_t BufferPool::trim()
+{
+	return m_shared->trim();
+}
+
+// BufferPool
+#pragma endregion
+
+} // namespace cppx
@@ -0,0 +1,226 @@
+#include "cppxQueue.hpp"
+#include "cppxException.hpp"
+
+#include <thread>
+#include <utility>
+
+namespace {
+namespace queueexc {
+constexpr const char *no_capacity = "A queue needs a capacity of at least one";
+} // namespace queueexc
+
+namespace queueing {
+inline std::size_t roundCapacity(std::size_t capacity)
+{
+	std::size_t result = 2;
+
+	while (result < capacity)
+		result <<= 1;
+
+	return result;
+}
+} // namespace queueing
+} // namespace
+
+namespace cppx {
+
+#pragma region BufferQueue
+
+struct BufferQueue::Slot {
+	//! @brief Equals the push position of the lap when free, and that position + 1 when filled
+	std::atomic<std::size_t> sequence;
+	Buffer value;
+};
+
+BufferQueue::BufferQueue(std::size_t capacity)
+    : m_pushAt(0), m_popAt(0)
+{
+	if (!capacity)
+		throw Exception(Exception::makeCallString(__FUNCTION__, capacity), queueexc::no_capacity);
+
+	const auto slots = queueing::roundCapacity(capacity);
+
+	m_slots.reset(new Slot[slots]);
+	m_mask = slots - 1;
+
+	for (std::size_t i = 0; i < slots; ++i)
+		m_slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+BufferQueue::~BufferQueue() = default;
+
+std::size_t BufferQueue::capacity() const noexcept
+{
+	return m_mask + 1;
+}
+
+std::size_t BufferQueue::size() const noexcept
+{
+	const auto popAt = m_popAt.load(std::memory_order_acquire);
+	const auto pushAt = m_pushAt.load(std::memory_order_acquire);
+
+	return pushAt > popAt ? pushAt - popAt : 0;
+}
+
+bool BufferQueue::tryPush(Buffer &&value) noexcept
+{
+	auto position = m_pushAt.load(std::memory_order_relaxed);
+	Slot *slot;
+
+	for (;;) {
+		slot = &m_slots[position & m_mask];
+
+		const auto sequence = slot->sequence.load(std::memory_order_acquire);
+		const auto lag = static_cast<std::ptrdiff_t>(sequence - position);
+
+		if (!lag) {
+			if (m_pushAt.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (lag < 0) {
+			// the slot still holds the buffer pushed a lap ago
+			return false;
+		}
+		else {
+			position = m_pushAt.load(std::memory_order_relaxed);
+		}
+	}
+
+	slot->value = std::move(value);
+	slot->sequence.store(position + 1, std::memory_order_release);
+
+	return true;
+}
+
+bool BufferQueue::tryPop(Buffer &value) noexcept
+{
+	auto position = m_popAt.load(std::memory_order_relaxed);
+	Slot *slot;
+
+	for (;;) {
+		slot = &m_slots[position & m_mask];
+
+		const auto sequence = slot->sequence.load(std::memory_order_acquire);
+		const auto lag = static_cast<std::ptrdiff_t>(sequence - (position + 1));
+
+		if (!lag) {
+			if (m_popAt.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (lag < 0) {
+			// nothing has been pushed into the slot on this lap yet
+			return false;
+		}
+		else {
+			position = m_popAt.load(std::memory_order_relaxed);
+		}
+	}
+
+	value = std::move(slot->value);
+	slot->sequence.store(position + m_mask + 1, std::memory_order_release);
+
+	return true;
+}
+
+void BufferQueue::push(Buffer &&value) noexcept
+{
+	while (!tryPush(std::move(value)))
+		std::this_thread::yield();
+}
+
+[[nodiscard]] Buffer BufferQueue::pop() noexcept
+{
+	Buffer result;
+
+	while (!tryPop(result))
+		std::this_thread::yield();
+
+	return result;
+}
+
+// BufferQueue
+#pragma endregion
+
+#pragma region SpscBufferQueue
+
+SpscBufferQueue::SpscBufferQueue(std::size_t capacity)
+    : m_tail(0), m_headCache(0), m_head(0), m_tailCache(0)
+{
+	if (!capacity)
+		throw Exception(Exception::makeCallString(__FUNCTION__, capacity), queueexc::no_capacity);
+
+	const auto slots = queueing::roundCapacity(capacity);
+
+	m_slots.reset(new Buffer[slots]);
+	m_mask = slots - 1;
+}
+
+SpscBufferQueue::~SpscBufferQueue() = default;
+
+std::size_t SpscBufferQueue::capacity() const noexcept
+{
+	return m_mask + 1;
+}
+
+std::size_t SpscBufferQueue::size() const noexcept
+{
+	const auto head = m_head.load(std::memory_order_acquire);
+	const auto tail = m_tail.load(std::memory_order_acquire);
+
+	return tail > head ? tail - head : 0;
+}
+
+bool SpscBufferQueue::tryPush(Buffer &&value) noexcept
+{
+	const auto tail = m_tail.load(std::memory_order_relaxed);
+
+	if (tail - m_headCache > m_mask) {
+		m_headCache = m_head.load(std::memory_order_acquire);
+
+		if (tail - m_headCache > m_mask)
+			return false;
+	}
+
+	m_slots[tail & m_mask] = std::move(value);
+	m_tail.store(tail + 1, std::memory_order_release);
+
+	return true;
+}
+
+bool SpscBufferQueue::tryPop(Buffer &value) noexcept
+{
+	const auto head = m_head.load(std::memory_order_relaxed);
+
+	if (head == m_tailCache) {
+		m_tailCache = m_tail.load(std::memory_order_acquire);
+
+		if (head == m_tailCache)
+			return false;
+	}
+
+	value = std::move(m_slots[head & m_mask]);
+	m_head.store(head + 1, std::memory_order_release);
+
+	return true;
+}
+
+void SpscBufferQueue::push(Buffer &&value) noexcept
+{
+	while (!tryPush(std::move(value)))
+		std::this_thread::yield();
+}
+
+[[nodiscard]] Buffer SpscBufferQueue::pop() noexcept
+{
+	Buffer result;
+
+	while (!tryPop(result))
+		std::this_thread::yield();
+
+	return result;
+}
+
+// SpscBufferQueue
+#pragma endregion
+
+} // namespace cppx
@@ -0,0 +1,236 @@
+#include "cppxSecure.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace {
+namespace secure {
+constexpr const std::size_t page = 4096;
+constexpr const std::size_t region_size = 16 * page;
+constexpr const std::size_t min_class = 16;
+
+//! @brief Size classes 16, 32, ... max_pooled_size
+constexpr const std::size_t class_count = 9;
+
+static_assert((min_class << (class_count - 1)) == cppx::Secure::max_pooled_size, "size classes must end at max_pooled_size");
+
+// called through a volatile pointer, so the stores can't be proven dead
+void *(*const volatile zero)(void *, int, std::size_t) = std::memset;
+
+std::atomic<bool> locked(true);
+
+inline std::size_t classOf(std::size_t size)
+{
+	std::size_t index = 0;
+
+	while ((min_class << index) < size)
+		++index;
+
+	return index;
+}
+
+inline std::size_t roundUp(std::size_t size, std::size_t multiple)
+{
+	return (size + multiple - 1) / multiple * multiple;
+}
+
+#if defined(__linux__)
+//! @brief Maps |length| locked bytes between two inaccessible guard pages
+void *mapGuarded(std::size_t length)
+{
+	const auto mapping = static_cast<std::uint8_t *>(
+	    mmap(nullptr, length + 2 * page, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+
+	if (mapping == MAP_FAILED)
+		return nullptr;
+
+	const auto data = mapping + page;
+
+	if (mprotect(data, length, PROT_READ | PROT_WRITE)) {
+		munmap(mapping, length + 2 * page);
+		return nullptr;
+	}
+
+	if (mlock(data, length))
+		locked = false;
+
+#if defined(MADV_DONTDUMP)
+	madvise(data, length, MADV_DONTDUMP);
+#endif
+
+	return data;
+}
+
+void unmapGuarded(void *data, std::size_t length)
+{
+	munlock(data, length);
+	munmap(static_cast<std::uint8_t *>(data) - page, length + 2 * page);
+}
+#else  // defined(__linux__)
+void *mapGuarded(std::size_t length)
+{
+	return std::calloc(length, 1);
+}
+
+void unmapGuarded(void *data, std::size_t)
+{
+	std::free(data);
+}
+#endif // defined(__linux__)
+
+/**
+ * @brief Free slots of every size class
+ * @details Regions are never unmapped; their slots are reused by later buffers.
+ */
+struct Pool {
+	std::mutex mutex;
+	std::vector<void *> slots[class_count];
+};
+
+Pool &pool()
+{
+	// never destroyed, so buffers released during static destruction still find it
+	static Pool *const instance = new Pool();
+	return *instance;
+}
+
+void *allocate(std::size_t size)
+{
+	if (size > cppx::Secure::max_pooled_size)
+		return mapGuarded(roundUp(size, page));
+
+	const auto index = classOf(size);
+	const auto slotSize = min_class << index;
+
+	auto &instance = pool();
+	std::lock_guard<std::mutex> lock(instance.mutex);
+
+	auto &slots = instance.slots[index];
+
+	if (slots.empty()) {
+		const auto region = static_cast<std::uint8_t *>(mapGuarded(region_size));
+		if (!region)
+			return nullptr;
+
+		// reversed, so the slots are handed out from the start of the region
+		for (std::size_t offset = region_size; offset >= slotSize; offset -= slotSize)
+			slots.push_back(region + offset - slotSize);
+	}
+
+	const auto result = slots.back();
+	slots.pop_back();
+
+	return result;
+}
+
+void release(void *data, std::size_t size)
+{
+	if (!data)
+		return;
+
+	if (size > cppx::Secure::max_pooled_size) {
+		zero(data, 0, roundUp(size, page));
+		unmapGuarded(data, roundUp(size, page));
+		return;
+	}
+
+	const auto index = classOf(size);
+	zero(data, 0, min_class << index);
+
+	auto &instance = pool();
+	std::lock_guard<std::mutex> lock(instance.mutex);
+
+	instance.slots[index].push_back(data);
+}
+} // namespace secure
+} // namespace
+
+namespace cppx {
+
+/** @static */
+const BufferManager Secure::secureManager = {
+    "secureManager",
+    {1, 1, 0},
+    [](std::size_t size) -> void * { return secure::allocate(size); },
+    [](void *ptr, std::size_t size) -> void { secure::release(ptr, size); },
+    nullptr,
+    // slots are wiped on release and new mappings are zero pages, so every block starts zeroed
+    [](std::size_t size) -> void * { return secure::allocate(size); }};
+
+/** @static */
+void Secure::wipe(void *data, std::size_t size) noexcept
+{
+	if (data && size)
+		secure::zero(data, 0, size);
+}
+
+/** @static */
+void Secure::wipe(Buffer &buffer) noexcept
+{
+	const auto manager = buffer.manager();
+
+	// read-only data, such as string literals behind Buffer::Static, can't be written
+	if (!manager || !manager->flags.modify)
+		return;
+
+	wipe(buffer.data(), buffer.totalsize());
+}
+
+/** @static */
+bool Secure::equal(const void *left, const void *right, std::size_t size) noexcept
+{
+	const auto a = static_cast<const std::uint8_t *>(left);
+	const auto b = static_cast<const std::uint8_t *>(right);
+
+	// independent lanes so the word loop vectorizes
+	std::uint64_t lanes[4] = {};
+	std::size_t i = 0;
+
+	for (; i + sizeof(lanes) <= size; i += sizeof(lanes)) {
+		std::uint64_t x[4], y[4];
+
+		std::memcpy(x, a + i, sizeof(x));
+		std::memcpy(y, b + i, sizeof(y));
+
+		for (std::size_t lane = 0; lane < 4; ++lane)
+			lanes[lane] |= x[lane] ^ y[lane];
+	}
+
+	std::uint64_t difference = lanes[0] | lanes[1] | lanes[2] | lanes[3];
+
+	for (; i < size; ++i)
+		difference |= a[i] ^ b[i];
+
+#if defined(__GNUC__)
+	// keeps the compiler from turning the accumulation into an early exit
+	__asm__("" : "+r"(difference));
+#endif
+
+	// 1 if difference is zero, without a branch on it
+	return static_cast<bool>(1 & ((difference | (0 - difference)) >> 63 ^ 1));
+}
+
+/** @static */
+bool Secure::equal(const Buffer &left, const Buffer &right) noexcept
+{
+	if (left.size() != right.size())
+		return false;
+
+	return !left.size() || equal(left.data(), right.data(), left.size());
+}
+
+/** @static */
+bool Secure::locked() noexcept
+{
+	return secure::locked;
+}
+
+} // namespace cppx
@@ -0,0 +1,246 @@
+#include "cppxTrace.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <type_traits>
+
+namespace {
+namespace trace {
+static_assert(std::is_trivially_copyable<cppx::TraceEvent>::value, "events are copied word by word");
+
+constexpr const std::size_t event_words = (sizeof(cppx::TraceEvent) + sizeof(std::uint64_t) - 1) / sizeof(std::uint64_t);
+
+struct Slot {
+	//! @brief 2 * ticket + 1 while the event is written, 2 * ticket + 2 once it is complete
+	std::atomic<std::uint64_t> sequence{0};
+
+	//! @brief The event, in words a reader may load while a writer stores them
+	std::atomic<std::uint64_t> words[event_words];
+
+	/**
+	 * @brief Makes the slot the writer's for |ticket|
+	 * @details Fails if another writer, a lap behind or ahead, holds it or has
+	 *          filled it with a newer event; the event is then left out of the ring.
+	 */
+	bool claim(std::uint64_t ticket) noexcept
+	{
+		auto current = sequence.load(std::memory_order_relaxed);
+
+		do {
+			if ((current & 1) || current >= 2 * ticket + 2)
+				return false;
+		} while (!sequence.compare_exchange_weak(current, 2 * ticket + 1, std::memory_order_relaxed));
+
+		return true;
+	}
+
+	void store(const cppx::TraceEvent &event) noexcept
+	{
+		std::uint64_t copy[event_words] = {};
+		std::memcpy(copy, &event, sizeof(event));
+
+		for (std::size_t i = 0; i < event_words; ++i)
+			words[i].store(copy[i], std::memory_order_relaxed);
+	}
+
+	cppx::TraceEvent load() const noexcept
+	{
+		std::uint64_t copy[event_words];
+
+		for (std::size_t i = 0; i < event_words; ++i)
+			copy[i] = words[i].load(std::memory_order_relaxed);
+
+		cppx::TraceEvent result;
+		std::memcpy(&result, copy, sizeof(result));
+
+		return result;
+	}
+};
+
+Slot ring[cppx::BufferTrace::ring_size];
+
+std::atomic<std::uint64_t> head(0);
+std::atomic<std::uint64_t> floor(0);
+std::atomic<bool> enabled(true);
+
+std::atomic<bool> hasCallback(false);
+cppx::BufferTrace::Callback callback;
+
+std::atomic<std::uint32_t> nextThread(0);
+thread_local const std::uint32_t thread = nextThread++;
+thread_local const char *tag = nullptr;
+
+std::uint64_t now() noexcept
+{
+	static const auto epoch = std::chrono::steady_clock::now();
+
+	return static_cast<std::uint64_t>(
+	    std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+}
+
+void writeString(std::ostream &stream, const char *text)
+{
+	stream << '"';
+
+	for (; *text; ++text) {
+		if (*text == '"' || *text == '\\')
+			stream << '\\';
+
+		if (static_cast<unsigned char>(*text) >= 0x20)
+			stream << *text;
+	}
+
+	stream << '"';
+}
+} // namespace trace
+} // namespace
+
+namespace cppx {
+#pragma region TraceEvent
+
+/** @static */
+const char *TraceEvent::typeName(Type type) noexcept
+{
+	switch (type) {
+	case CREATE: return "create";
+	case ALLOCATE: return "allocate";
+	case GROW: return "grow";
+	case DETACH: return "detach";
+	case RELEASE: return "release";
+	}
+
+	return "unknown";
+}
+
+// TraceEvent
+#pragma endregion
+#pragma region BufferTrace
+
+BufferTrace::Scope::Scope(const char *tag) noexcept
+    : m_previous(trace::tag)
+{
+	trace::tag = tag;
+}
+
+BufferTrace::Scope::~Scope()
+{
+	trace::tag = m_previous;
+}
+
+/** @static */
+void BufferTrace::record(TraceEvent::Type type, std::size_t size, const BufferManager *manager) noexcept
+{
+	if (!trace::enabled.load(std::memory_order_relaxed))
+		return;
+
+	const TraceEvent event = {type, trace::now(), size, manager, trace::tag, trace::thread};
+
+	const auto ticket = trace::head.fetch_add(1, std::memory_order_relaxed);
+	auto &slot = trace::ring[ticket % ring_size];
+
+	if (slot.claim(ticket)) {
+		std::atomic_thread_fence(std::memory_order_release);
+
+		slot.store(event);
+
+		slot.sequence.store(2 * ticket + 2, std::memory_order_release);
+	}
+
+	if (trace::hasCallback.load(std::memory_order_acquire))
+		trace::callback(event);
+}
+
+/** @static */
+void BufferTrace::setEnabled(bool enabled) noexcept
+{
+	trace::enabled = enabled;
+}
+
+/** @static */
+bool BufferTrace::enabled() noexcept
+{
+	return trace::enabled;
+}
+
+/** @static */
+void BufferTrace::setCallback(Callback callback)
+{
+	trace::hasCallback = false;
+	trace::callback = std::move(callback);
+	trace::hasCallback = bool(trace::callback);
+}
+
+/** @static */
+std::vector<TraceEvent> BufferTrace::events()
+{
+	const auto end = trace::head.load(std::memory_order_acquire);
+	const auto floor = trace::floor.load(std::memory_order_relaxed);
+
+	auto begin = end > ring_size ? end - ring_size : 0;
+	begin = begin > floor ? begin : floor;
+
+	std::vector<TraceEvent> result;
+	result.reserve(static_cast<std::size_t>(end - begin));
+
+	for (auto ticket = begin; ticket < end; ++ticket) {
+		const auto &slot = trace::ring[ticket % ring_size];
+
+		// skips events still being written, or already overwritten by a newer one
+		if (slot.sequence.load(std::memory_order_acquire) != 2 * ticket + 2)
+			continue;
+
+		const auto event = slot.load();
+		std::atomic_thread_fence(std::memory_order_acquire);
+
+		if (slot.sequence.load(std::memory_order_relaxed) == 2 * ticket + 2)
+			result.push_back(event);
+	}
+
+	return result;
+}
+
+/** @static */
+void BufferTrace::clear() noexcept
+{
+	trace::floor = trace::head.load();
+}
+
+/** @static */
+void BufferTrace::exportChrome(std::ostream &stream, const std::vector<TraceEvent> &events)
+{
+	stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+	for (std::size_t i = 0; i < events.size(); ++i) {
+		const auto &event = events[i];
+
+		stream << (i ? ",\n" : "\n")
+		       << "{\"name\":\"" << TraceEvent::typeName(event.type) << "\""
+		       << ",\"cat\":\"cppx.buffer\",\"ph\":\"i\",\"s\":\"t\",\"pid\":0"
+		       << ",\"tid\":" << event.thread
+		       << ",\"ts\":" << event.timestamp / 1000 << '.' << (event.timestamp % 1000) / 100 << (event.timestamp % 100) / 10 << event.timestamp % 10
+		       << ",\"args\":{\"size\":" << event.size
+		       << ",\"manager\":";
+
+		trace::writeString(stream, event.manager ? event.manager->name : "");
+
+		if (event.tag) {
+			stream << ",\"tag\":";
+			trace::writeString(stream, event.tag);
+		}
+
+		stream << "}}";
+	}
+
+	stream << "\n]}\n";
+}
+
+/** @static */
+void BufferTrace::exportChrome(std::ostream &stream)
+{
+	exportChrome(stream, events());
+}
+
+// BufferTrace
+#pragma endregion
+} // namespace cppx
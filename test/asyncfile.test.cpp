@@ -0,0 +1,437 @@
+#include <catch2/catch_all.hpp>
+#include <cstdio>
+#include <fcntl.h>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+#include "cppxAsyncFile.hpp"
+#include "cppxBuffer.hpp"
+
+namespace {
+std::string temporaryPath(const char *name)
+{
+	return (std::filesystem::temp_directory_path() / (std::string("cppx_asyncfile_") + name)).string();
+}
+
+cppx::Buffer pattern(std::size_t size)
+{
+	auto result = cppx::Buffer::Heap(size);
+
+	for (std::size_t i = 0; i < size; ++i)
+		result[i] = static_cast<std::uint8_t>(i * 7 + i / 251);
+
+	return result;
+}
+
+//! @brief Small chunks and a shallow ring, so files take many transfers and some wait in the backlog
+std::vector<cppx::IoOptions> engines()
+{
+	cppx::IoOptions options;
+	options.chunk = 4096;
+	options.depth = 8;
+
+	std::vector<cppx::IoOptions> result;
+
+	options.backend = cppx::IoBackend::threads;
+	result.push_back(options);
+
+	if (cppx::IoEngine::uringAvailable()) {
+		options.backend = cppx::IoBackend::uring;
+		result.push_back(options);
+	}
+
+	return result;
+}
+
+#ifdef CPPX_ASYNCFILE_COROUTINES
+//! @brief Eagerly started coroutine with no result, enough to drive co_await
+struct Detached {
+	struct promise_type {
+		Detached get_return_object() { return {}; }
+		std::suspend_never initial_suspend() noexcept { return {}; }
+		std::suspend_never final_suspend() noexcept { return {}; }
+		void return_void() {}
+		void unhandled_exception() { std::terminate(); }
+	};
+};
+
+Detached copyFile(cppx::IoEngine &engine, std::string from, std::string to, std::shared_ptr<cppx::IoTask<std::size_t>::State> result)
+{
+	auto contents = co_await engine.read(from);
+	result->complete(co_await engine.write(to, contents));
+}
+#endif
+} // namespace
+
+TEST_CASE("cppx::IoEngine", "[IoEngine]")
+{
+	using cppx::Buffer;
+	using cppx::IoEngine;
+
+	const auto path = temporaryPath("engine");
+
+	SECTION("backends")
+	{
+		REQUIRE(IoEngine().backend() == (IoEngine::uringAvailable() ? cppx::IoBackend::uring : cppx::IoBackend::threads));
+
+		cppx::IoOptions options;
+		options.backend = cppx::IoBackend::uring;
+
+		if (IoEngine::uringAvailable())
+			REQUIRE(IoEngine(options).backend() == cppx::IoBackend::uring);
+		else
+			REQUIRE_THROWS(IoEngine(options));
+	}
+
+	SECTION("files round-trip in chunks")
+	{
+		for (const auto &options : engines()) {
+			IoEngine engine(options);
+			const auto contents = pattern(100000);
+
+			REQUIRE(engine.write(path, contents).get() == 100000);
+
+			const auto read = engine.read(path).get();
+			REQUIRE(read == contents);
+			REQUIRE(read.manager() == Buffer::onHeap);
+
+			REQUIRE(engine.write(path, Buffer()).get() == 0);
+			REQUIRE(engine.read(path).get().size() == 0);
+		}
+	}
+
+	SECTION("many operations in flight")
+	{
+		for (const auto &options : engines()) {
+			IoEngine engine(options);
+			std::vector<cppx::IoTask<std::size_t>> writes;
+
+			for (std::size_t i = 0; i < 32; ++i)
+				writes.push_back(engine.write(path + std::to_string(i), pattern(10000 + i)));
+
+			for (auto &write : writes)
+				write.get();
+
+			std::vector<cppx::IoTask<Buffer>> reads;
+
+			for (std::size_t i = 0; i < 32; ++i)
+				reads.push_back(engine.read(path + std::to_string(i)));
+
+			for (std::size_t i = 0; i < 32; ++i) {
+				REQUIRE(reads[i].get() == pattern(10000 + i));
+				std::remove((path + std::to_string(i)).c_str());
+			}
+		}
+	}
+
+	SECTION("continuations run once the operation is done")
+	{
+		for (const auto &options : engines()) {
+			IoEngine engine(options);
+
+			auto task = engine.write(path, pattern(10));
+			task.wait();
+
+			bool ran = false;
+			task.then([&ran]() { ran = true; });
+
+			REQUIRE(ran);
+			REQUIRE(task.ready());
+		}
+	}
+
+	SECTION("errors")
+	{
+		IoEngine engine;
+
+		REQUIRE_THROWS(engine.read(temporaryPath("missing/file")));
+		REQUIRE_THROWS(engine.write(temporaryPath("missing/file"), pattern(10)));
+	}
+
+#ifdef CPPX_ASYNCFILE_COROUTINES
+	SECTION("co_await")
+	{
+		for (const auto &options : engines()) {
+			IoEngine engine(options);
+			REQUIRE(engine.write(path, pattern(50000)).get() == 50000);
+
+			auto state = std::make_shared<cppx::IoTask<std::size_t>::State>();
+			cppx::IoTask<std::size_t> copied(state);
+
+			copyFile(engine, path, path + ".copy", state);
+
+			REQUIRE(copied.get() == 50000);
+			REQUIRE(engine.read(path + ".copy").get() == pattern(50000));
+			std::remove((path + ".copy").c_str());
+		}
+	}
+#endif
+
+	std::remove(path.c_str());
+}
+
+TEST_CASE("cppx::FileReader and cppx::FileWriter", "[IoEngine]")
+{
+	using cppx::Buffer;
+	using cppx::FileReader;
+	using cppx::FileWriter;
+	using cppx::IoEngine;
+
+	const auto path = temporaryPath("stream");
+
+	SECTION("pieces are appended in place")
+	{
+		for (const auto &options : engines()) {
+			IoEngine engine(options);
+			const auto contents = pattern(200000);
+
+			{
+				FileWriter writer(engine, path);
+				std::vector<cppx::IoTask<std::size_t>> writes;
+
+				for (std::size_t offset = 0; offset < contents.size(); offset += 30000)
+					writes.push_back(writer.write(contents.range(offset, offset + 30000 < contents.size() ? offset + 30000 : contents.size())));
+
+				for (auto &write : writes)
+					write.get();
+
+				REQUIRE(writer.offset() == 200000);
+			}
+
+			FileReader reader(engine, path);
+			REQUIRE(reader.size() == 200000);
+
+			Buffer target;
+			std::size_t read = 0;
+
+			while (const auto bytes = reader.readInto(target, 50000).get())
+				read += bytes;
+
+			REQUIRE(read == 200000);
+			REQUIRE(target == contents);
+
+			// a tail that is large enough is used as it is
+			auto tailed = Buffer::HeapPreall(1000);
+			const auto before = tailed.data();
+
+			FileReader again(engine, path);
+			REQUIRE(again.readInto(tailed, 1000).get() == 1000);
+
+			REQUIRE(tailed.data() == before);
+			REQUIRE(tailed.preallocated() == 0);
+			REQUIRE(tailed == contents.range(0, 1000));
+		}
+	}
+
+	SECTION("pieces larger than a tail are cut")
+	{
+		for (const auto &options : engines()) {
+			IoEngine engine(options);
+
+			{
+				FileWriter writer(engine, path);
+				writer.write(pattern(100000)).get();
+			}
+
+			FileReader reader(engine, path);
+			Buffer target;
+
+			REQUIRE(reader.readInto(target, 100000).get() == cppx::BufferCore::max_preall);
+			REQUIRE(target == pattern(100000).range(0, cppx::BufferCore::max_preall));
+		}
+	}
+
+	SECTION("writers append")
+	{
+		for (const auto &options : engines()) {
+			IoEngine engine(options);
+
+			{
+				FileWriter writer(engine, path);
+				writer.write(pattern(100)).get();
+			}
+
+			{
+				FileWriter writer(engine, path, true);
+				REQUIRE(writer.offset() == 100);
+				writer.write(pattern(100)).get();
+			}
+
+			REQUIRE(engine.read(path).get() == pattern(100).append(pattern(100)));
+		}
+	}
+
+	SECTION("shared targets are detached first")
+	{
+		for (const auto &options : engines()) {
+			IoEngine engine(options);
+
+			{
+				FileWriter writer(engine, path);
+				writer.write(pattern(10)).get();
+			}
+
+			auto target = Buffer::HeapFrom((void *)"ab", 2);
+			const auto copy = target;
+
+			FileReader reader(engine, path);
+			REQUIRE(reader.readInto(target, 10).get() == 10);
+
+			REQUIRE(copy.size() == 2);
+			REQUIRE(target.size() == 12);
+			REQUIRE(target.range(2, 12) == pattern(10));
+		}
+	}
+
+	SECTION("targets shared while the read is in flight fail the task")
+	{
+		cppx::IoOptions options;
+		options.backend = cppx::IoBackend::threads;
+		options.threads = 1;
+
+		IoEngine engine(options);
+		REQUIRE(engine.write(path, pattern(100)).get() == 100);
+
+		FileReader reader(engine, path);
+		std::promise<void> gate;
+		auto opened = gate.get_future().share();
+		char byte;
+
+		// holds the only engine thread until the target has been shared
+		const auto fd = ::open(path.c_str(), O_RDONLY);
+		engine.submitRead(fd, &byte, 1, 0, [opened](std::size_t, int) { opened.wait(); });
+
+		Buffer target;
+		auto read = reader.readInto(target, 10);
+		const auto copy = target;
+
+		gate.set_value();
+		REQUIRE_THROWS(read.get());
+		REQUIRE(copy.size() == 0);
+
+		::close(fd);
+	}
+
+	SECTION("errors")
+	{
+		IoEngine engine;
+		REQUIRE_THROWS(FileReader(engine, temporaryPath("missing/file")));
+	}
+
+	std::remove(path.c_str());
+}
+
+TEST_CASE("cppx::PrefetchReader", "[IoEngine]")
+{
+	using cppx::Buffer;
+	using cppx::IoEngine;
+	using cppx::PrefetchOptions;
+	using cppx::PrefetchReader;
+
+	const auto path = temporaryPath("prefetch");
+	const auto contents = pattern(100000);
+
+	SECTION("chunks cover the file in order")
+	{
+		for (const auto &options : engines()) {
+			IoEngine engine(options);
+			REQUIRE(engine.write(path, contents).get() == 100000);
+
+			for (const std::size_t depth : {1, 2, 8}) {
+				PrefetchOptions prefetch;
+				prefetch.chunk = 4096;
+				prefetch.depth = depth;
+
+				PrefetchReader reader(engine, path, prefetch);
+				REQUIRE(reader.size() == 100000);
+
+				auto scanned = Buffer::Heap(0);
+				std::size_t chunks = 0;
+
+				while (const auto chunk = reader.next()) {
+					REQUIRE(chunk.size() == (chunks < 24 ? 4096 : 100000 - 24 * 4096));
+					scanned.selfAppend(chunk);
+					++chunks;
+				}
+
+				REQUIRE(chunks == 25);
+				REQUIRE(scanned == contents);
+				REQUIRE(!reader.next());
+
+				// the pooled buffers, plus the last, shorter chunk
+				REQUIRE(reader.allocations() == depth + 2);
+			}
+		}
+	}
+
+	SECTION("a scan of whole chunks allocates depth + 1 buffers")
+	{
+		IoEngine engine;
+		REQUIRE(engine.write(path, contents).get() == 100000);
+
+		PrefetchOptions prefetch;
+		prefetch.chunk = 5000;
+		prefetch.depth = 3;
+
+		PrefetchReader reader(engine, path, prefetch);
+		std::size_t chunks = 0;
+
+		while (const auto chunk = reader.next())
+			chunks += chunk == contents.range(chunks * 5000, (chunks + 1) * 5000);
+
+		REQUIRE(chunks == 20);
+		REQUIRE(reader.allocations() == 4);
+	}
+
+	SECTION("chunks still held are not reused")
+	{
+		IoEngine engine;
+		REQUIRE(engine.write(path, contents).get() == 100000);
+
+		PrefetchOptions prefetch;
+		prefetch.chunk = 10000;
+
+		PrefetchReader reader(engine, path, prefetch);
+		std::vector<Buffer> held;
+
+		while (auto chunk = reader.next())
+			held.push_back(chunk);
+
+		REQUIRE(held.size() == 10);
+		REQUIRE(reader.allocations() == 10);
+
+		for (std::size_t i = 0; i < held.size(); ++i)
+			REQUIRE(held[i] == contents.range(i * 10000, (i + 1) * 10000));
+	}
+
+	SECTION("readers can stop early")
+	{
+		IoEngine engine;
+		REQUIRE(engine.write(path, contents).get() == 100000);
+
+		PrefetchOptions prefetch;
+		prefetch.chunk = 1000;
+		prefetch.depth = 16;
+
+		PrefetchReader reader(engine, path, prefetch);
+		REQUIRE(reader.next() == contents.range(0, 1000));
+	}
+
+	SECTION("options are checked")
+	{
+		IoEngine engine;
+		REQUIRE(engine.write(path, contents).get() == 100000);
+
+		PrefetchOptions prefetch;
+		prefetch.depth = 0;
+
+		REQUIRE_THROWS(PrefetchReader(engine, path, prefetch));
+		REQUIRE_THROWS(PrefetchReader(engine, temporaryPath("missing/file")));
+	}
+
+	std::remove(path.c_str());
+}
@@ -0,0 +1,121 @@
+#include <algorithm>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <vector>
+
+#include "cppxBits.hpp"
+#include "cppxBuffer.hpp"
+
+namespace {
+cppx::Buffer pattern(std::size_t size, std::uint32_t seed)
+{
+	auto result = cppx::Buffer::Heap(size);
+
+	for (std::size_t i = 0; i < size; ++i) {
+		seed = seed * 1103515245u + 12345u;
+		result[i] = static_cast<std::uint8_t>(seed >> 16);
+	}
+
+	return result;
+}
+
+bool bitOf(const cppx::Buffer &buffer, std::size_t bit)
+{
+	return (buffer[bit / 8] >> (bit % 8)) & 1;
+}
+} // namespace
+
+TEST_CASE("cppx::Bits", "[Bits]")
+{
+	using cppx::Bits;
+	using cppx::Buffer;
+
+	const auto size = GENERATE(std::size_t(1), std::size_t(7), std::size_t(8), std::size_t(9), std::size_t(33), std::size_t(100));
+
+	const auto left = pattern(size, 1);
+	const auto right = pattern(size, 2);
+
+	SECTION("bitwise operations")
+	{
+		const auto conjunction = Bits::bitAnd(left, right);
+		const auto disjunction = Bits::bitOr(left, right);
+		const auto exclusive = Bits::bitXor(left, right);
+		const auto negation = Bits::bitNot(left);
+
+		for (std::size_t i = 0; i < size; ++i) {
+			REQUIRE(conjunction[i] == (left[i] & right[i]));
+			REQUIRE(disjunction[i] == (left[i] | right[i]));
+			REQUIRE(exclusive[i] == (left[i] ^ right[i]));
+			REQUIRE(negation[i] == static_cast<std::uint8_t>(~left[i]));
+		}
+
+		auto target = left.clone();
+		REQUIRE(Bits::selfAnd(target, right) == conjunction);
+
+		target = left.clone();
+		REQUIRE(Bits::selfOr(target, right) == disjunction);
+
+		// a shared copy is detached, not written through
+		const auto shared = left;
+		target = left;
+		REQUIRE(Bits::selfXor(target, right) == exclusive);
+		REQUIRE(shared == left);
+		REQUIRE(Bits::selfNot(target) == Bits::bitNot(exclusive));
+
+		REQUIRE_THROWS(Bits::bitAnd(left, left.range(0, size - 1, Buffer::onHeap)));
+		REQUIRE_THROWS(Bits::selfOr(target, Buffer()));
+
+		auto readonly = Buffer::Static(left.data(), size);
+		REQUIRE_THROWS(Bits::selfNot(readonly));
+	}
+
+	SECTION("queries")
+	{
+		std::size_t expected = 0;
+		for (std::size_t bit = 0; bit < size * 8; ++bit)
+			expected += bitOf(left, bit);
+
+		REQUIRE(Bits::popcount(left) == expected);
+		REQUIRE(Bits::popcount(Buffer()) == 0);
+
+		auto zeros = Buffer::Heap(size);
+		std::fill(zeros.begin(), zeros.end(), 0);
+
+		REQUIRE(Bits::findFirstSet(zeros) == Bits::npos);
+		REQUIRE(Bits::findFirstUnset(Bits::bitNot(zeros)) == Bits::npos);
+
+		const auto bit = GENERATE_COPY(std::size_t(0), size * 4 + 3, size * 8 - 1);
+
+		Bits::set(zeros, bit);
+		REQUIRE(Bits::test(zeros, bit));
+		REQUIRE(Bits::findFirstSet(zeros) == bit);
+		REQUIRE(Bits::findFirstUnset(Bits::bitNot(zeros)) == bit);
+		REQUIRE(Bits::popcount(zeros) == 1);
+
+		Bits::clear(zeros, bit);
+		REQUIRE_FALSE(Bits::test(zeros, bit));
+		REQUIRE(Bits::popcount(zeros) == 0);
+
+		REQUIRE_THROWS(Bits::test(zeros, size * 8));
+		REQUIRE_THROWS(Bits::set(zeros, size * 8));
+	}
+
+	SECTION("shifts")
+	{
+		const auto count = GENERATE(std::size_t(0), std::size_t(1), std::size_t(7), std::size_t(8), std::size_t(13), std::size_t(64), std::size_t(67), std::size_t(800));
+
+		const auto up = Bits::shiftLeft(left, count);
+		const auto down = Bits::shiftRight(left, count);
+
+		for (std::size_t bit = 0; bit < size * 8; ++bit) {
+			REQUIRE(bitOf(up, bit) == (bit >= count && bitOf(left, bit - count)));
+			REQUIRE(bitOf(down, bit) == (bit + count < size * 8 && bitOf(left, bit + count)));
+		}
+
+		auto target = left.clone();
+		REQUIRE(Bits::selfShiftLeft(target, count) == up);
+
+		target = left.clone();
+		REQUIRE(Bits::selfShiftRight(target, count) == down);
+	}
+}
@@ -1,7 +1,12 @@
+#include <algorithm>
 #include <array>
 #include <catch2/catch_all.hpp>
+#include <cstdlib>
+#include <cstring>
 #include <execution>
 #include <numeric>
+#include <sstream>
+#include <vector>
 
 #ifndef CPPX_BUFFER_DEBUG
 #define CPPX_BUFFER_DEBUG
@@ -143,6 +148,22 @@ TEST_CASE("cppx::Buffer", "[Buffer]")
 			             }));
 		}
 
+		SECTION("HeapZeroed constructor")
+		{
+			for (const auto size : {std::size_t(0), std::size_t(1), std::size_t(100), std::size_t(1) << 20}) {
+				const auto zeroed = Buffer::HeapZeroed(size);
+
+				REQUIRE(zeroed.size() == size);
+				REQUIRE(std::all_of(zeroed.begin(), zeroed.end(), [](std::uint8_t byte) { return byte == 0; }));
+			}
+
+			// managers without zeroAlloc are cleared after allocating
+			const auto arenaZeroed = Buffer::Zeroed(Buffer::onArena, 64);
+			REQUIRE(std::all_of(arenaZeroed.begin(), arenaZeroed.end(), [](std::uint8_t byte) { return byte == 0; }));
+
+			REQUIRE_THROWS(Buffer::Zeroed(Buffer::onStack, 4));
+		}
+
 		SECTION("Stack constructor")
 		{
 			const auto stackData = randomStackData();
@@ -246,6 +267,146 @@ TEST_CASE("cppx::Buffer", "[Buffer]")
 		REQUIRE(buf2 == s_heapbuf);
 	}
 
+	SECTION("move")
+	{
+		Buffer owner = s_heapbuf.clone();
+		const auto data = owner.data();
+
+		Buffer moved(std::move(owner));
+
+		REQUIRE(!owner);
+		REQUIRE(moved.data() == data);
+		REQUIRE(moved.refcount() == 1);
+
+		Buffer shared = moved;
+		owner = std::move(moved);
+
+		REQUIRE(!moved);
+		REQUIRE(owner.data() == data);
+		REQUIRE(owner.refcount() == 2);
+
+		// moving onto a buffer of the same data drops one reference
+		shared = std::move(owner);
+
+		REQUIRE(shared.data() == data);
+		REQUIRE(shared.refcount() == 1);
+	}
+
+	SECTION("copy-on-write")
+	{
+		const std::uint8_t data[] = {0x00, 0x01, 0x02, 0x03};
+		const auto original = Buffer(&Buffer::heapCowManager).selfClone(Buffer::Static((void *)data, sizeof(data)));
+
+		SECTION("copies share the data until modified")
+		{
+			auto copy = original;
+
+			REQUIRE(copy.data() == original.data());
+			REQUIRE(original.refcount() == 2);
+
+			copy[1] = 0x10;
+
+			REQUIRE(copy.data() != original.data());
+			REQUIRE(original.refcount() == 1);
+			REQUIRE(copy.refcount() == 1);
+			REQUIRE(original == Buffer::Static((void *)data, sizeof(data)));
+			REQUIRE(copy == Buffer::Static((void *)"\x00\x10\x02\x03", 4));
+		}
+
+		SECTION("self-modifying operations detach")
+		{
+			auto reversed = original;
+			reversed.selfReverse(1, 3);
+
+			auto inserted = original;
+			inserted.selfInsert(2, Buffer::Static((void *)"\xFF", 1));
+
+			auto erased = original;
+			erased.selfErase(0, 2);
+
+			REQUIRE(original == Buffer::Static((void *)data, sizeof(data)));
+			REQUIRE(reversed == Buffer::Static((void *)"\x00\x02\x01\x03", 4));
+			REQUIRE(inserted == Buffer::Static((void *)"\x00\x01\xFF\x02\x03", 5));
+			REQUIRE(erased == Buffer::Static((void *)"\x02\x03", 2));
+		}
+
+		SECTION("selfDetach copies the payload")
+		{
+			auto heapbuf = Buffer::HeapFrom((void *)data, sizeof(data));
+			auto shared = heapbuf;
+
+			REQUIRE(shared.data() == heapbuf.data());
+
+			shared.selfDetach();
+
+			REQUIRE(shared.data() != heapbuf.data());
+			REQUIRE(shared == heapbuf);
+			REQUIRE(heapbuf.refcount() == 1);
+		}
+
+		SECTION("copies past the reference limit get their own data")
+		{
+			auto heapbuf = Buffer::HeapFrom((void *)data, sizeof(data));
+			std::vector<Buffer> copies(cppx::BufferCore::max_refcount - 1, heapbuf);
+
+			REQUIRE(heapbuf.refcount() == cppx::BufferCore::max_refcount);
+			REQUIRE(heapbuf.shared());
+
+			const auto extra = heapbuf;
+
+			REQUIRE(extra.data() != heapbuf.data());
+			REQUIRE(extra == heapbuf);
+			REQUIRE(heapbuf.refcount() == cppx::BufferCore::max_refcount);
+
+			copies.clear();
+			REQUIRE_FALSE(heapbuf.shared());
+		}
+
+		SECTION("heap buffers without the flag keep sharing")
+		{
+			auto heapbuf = Buffer::HeapFrom((void *)data, sizeof(data));
+			auto shared = heapbuf;
+
+			shared[0] = 0x20;
+
+			REQUIRE(heapbuf[0] == 0x20);
+		}
+	}
+
+	SECTION("batch")
+	{
+		const char *const words[] = {"alpha", "", "gamma delta", "e"};
+
+		std::vector<Buffer::Span> spans;
+		for (const auto word : words)
+			spans.emplace_back(word, std::strlen(word));
+
+		auto batch = Buffer::HeapBatch(spans);
+
+		REQUIRE(batch.size() == 4);
+		REQUIRE(Buffer::HeapBatch({}).empty());
+		REQUIRE(batch[0].manager() == Buffer::onArena);
+		REQUIRE(batch[1].size() == 0);
+
+		for (std::size_t i = 0; i < spans.size(); ++i)
+			REQUIRE(batch[i] == Buffer::Static((void *)words[i], spans[i].second));
+
+		// slices are independent; growing one moves it into an arena of its own
+		batch[2].selfAppend(Buffer::Static((void *)"!", 1));
+		batch[0][0] = 'A';
+		batch.erase(batch.begin() + 1);
+
+		REQUIRE(batch[1] == Buffer::Static((void *)"gamma delta!", 12));
+		REQUIRE(batch[0] == Buffer::Static((void *)"Alpha", 5));
+		REQUIRE(batch[2] == Buffer::Static((void *)"e", 1));
+
+		const auto survivor = batch[2];
+		batch.clear();
+
+		REQUIRE(survivor == Buffer::Static((void *)"e", 1));
+		REQUIRE(Buffer(Buffer::onArena, 3).size() == 3);
+	}
+
 	SECTION("iterators")
 	{
 		std::size_t traditionalReduce = 0;
@@ -369,6 +530,53 @@ TEST_CASE("cppx::Buffer", "[Buffer]")
 		REQUIRE(stackbuf == Buffer::Static((void *)"\xF0\xE1\xA5\xB4\xC3\xD2\x96\x87", 8));
 	}
 
+	SECTION("selfFill")
+	{
+		std::uint8_t stackdata[8] = {0xF0, 0xE1, 0xD2, 0xC3, 0xB4, 0xA5, 0x96, 0x87};
+		Buffer stackbuf = Buffer::Stack(stackdata, sizeof(stackdata));
+
+		REQUIRE(stackbuf.selfFill(2, 6, 0x00) == Buffer::Static((void *)"\xF0\xE1\x00\x00\x00\x00\x96\x87", 8));
+		REQUIRE(stackbuf.selfFill(0xAA) == Buffer::Static((void *)"\xAA\xAA\xAA\xAA\xAA\xAA\xAA\xAA", 8));
+		auto heapbuf = stackbuf.clone(Buffer::onHeap);
+		REQUIRE(heapbuf.selfFill(heapbuf.begin() + 7, heapbuf.end(), 0x01) == Buffer::Static((void *)"\xAA\xAA\xAA\xAA\xAA\xAA\xAA\x01", 8));
+
+		REQUIRE_THROWS(stackbuf.selfFill(6, 2, 0x00));
+		REQUIRE_THROWS(stackbuf.selfFill(0, 9, 0x00));
+		Buffer readonly = s_staticbuf;
+		REQUIRE_THROWS(readonly.selfFill(0x00));
+		REQUIRE_NOTHROW(Buffer().selfFill(0x00));
+
+		SECTION("pattern")
+		{
+			const auto pattern = Buffer::Static((void *)"abc", 3);
+			auto buffer = Buffer::Heap(11);
+
+			REQUIRE(buffer.selfFill(pattern) == Buffer::Static((void *)"abcabcabcab", 11));
+			REQUIRE(buffer.selfFill(1, 6, Buffer::Static((void *)"xy", 2)) == Buffer::Static((void *)"axyxyxabcab", 11));
+			REQUIRE_THROWS(buffer.selfFill(Buffer()));
+
+			// a pattern sharing the data being filled still repeats its original bytes
+			auto self = Buffer::HeapFrom((void *)"0123", 4);
+			REQUIRE(self.selfFill(1, 4, self) == Buffer::Static((void *)"0012", 4));
+
+			auto large = Buffer::Heap(100000);
+			large.selfFill(pattern);
+			for (std::size_t i = 0; i < large.size(); ++i)
+				REQUIRE(large[i] == "abc"[i % 3]);
+		}
+
+		SECTION("copy-on-write")
+		{
+			auto original = Buffer(Buffer::onHeapCow).selfClone(Buffer::Static((void *)"abcd", 4));
+			auto copy = original;
+
+			copy.selfFill(0x00);
+
+			REQUIRE(original == Buffer::Static((void *)"abcd", 4));
+			REQUIRE(copy == Buffer::Static((void *)"\x00\x00\x00\x00", 4));
+		}
+	}
+
 	SECTION("insert")
 	{
 		std::uint8_t stackdata[8] = {0xF0, 0xE1, 0xD2, 0xC3, 0xB4, 0xA5, 0x96, 0x87};
@@ -432,11 +640,191 @@ TEST_CASE("cppx::Buffer", "[Buffer]")
 	{
 		REQUIRE_THROWS(s_staticbuf.erase(4, s_staticbuf.size()));
 		REQUIRE(s_staticbuf.erase(4, s_staticbuf.size(), Buffer::onHeap) == Buffer::Static((void *)"i am", 4));
+		REQUIRE(s_staticbuf.erase(1, 4, Buffer::onHeap) == Buffer::Static((void *)"i static data", 14));
 	}
 
 	SECTION("selfErase")
 	{
 		REQUIRE(s_staticbuf.clone(Buffer::onHeap).selfErase(4, s_staticbuf.size()) == Buffer::Static((void *)"i am", 4));
 		REQUIRE(s_staticbuf.clone(Buffer::onHeap).selfErase(0, s_staticbuf.size()) == Buffer());
+
+		auto large = Buffer::Heap(0x20000);
+		large[0x1FFFF] = 0x42;
+		large.selfErase(1, 0x1FFFF);
+
+		REQUIRE(large.size() == 2);
+		REQUIRE(large[1] == 0x42);
+		REQUIRE(large.preallocated() == 0);
+
+		// long tails are cut in place by the manager's reallocate
+		std::size_t reallocations = 0;
+		const cppx::BufferManager shrinking = {
+		    "shrinking",
+		    {1, 1, 0},
+		    Buffer::heapManager.alloc,
+		    Buffer::heapManager.release,
+		    [&reallocations](void *ptr, std::size_t, std::size_t size) -> void * {
+			    ++reallocations;
+			    return std::realloc(ptr, size);
+		    }};
+
+		auto output = Buffer(&shrinking, 0x20000);
+		output[0] = 0x42;
+		output.selfErase(1, output.size());
+
+		REQUIRE(reallocations == 1);
+		REQUIRE(output.size() == 1);
+		REQUIRE(output[0] == 0x42);
+	}
+
+	SECTION("reallocate")
+	{
+		auto buffer = Buffer::HeapFrom((void *)"abcdef", 6);
+
+		buffer.selfInsert(3, Buffer::Static((void *)"XYZ", 3));
+		REQUIRE(buffer == Buffer::Static((void *)"abcXYZdef", 9));
+		REQUIRE(buffer.preallocated() == 0);
+
+		buffer.selfPreallocate(7);
+		REQUIRE(buffer.preallocated() == 7);
+		REQUIRE(buffer == Buffer::Static((void *)"abcXYZdef", 9));
+
+		buffer.selfInsert(1, buffer);
+		REQUIRE(buffer == Buffer::Static((void *)"aabcXYZdefbcXYZdef", 18));
+
+		auto shared = buffer;
+		shared.selfAppend(Buffer::Static((void *)"!", 1));
+
+		REQUIRE(buffer.size() == 18);
+		REQUIRE(shared.size() == 19);
+
+		// managers without reallocate take the copying path
+		const cppx::BufferManager copying = {"copying", {1, 1, 0}, Buffer::heapManager.alloc, Buffer::heapManager.release};
+		auto copied = Buffer(&copying).selfClone(buffer);
+		copied.selfAppend(buffer).selfPreallocate(10);
+
+		REQUIRE(copied.range(0, 18, Buffer::onHeap) == buffer);
+		REQUIRE(copied.range(18, 36, Buffer::onHeap) == buffer);
+		REQUIRE(copied.preallocated() == 10);
+	}
+
+	SECTION("shrinkToFit")
+	{
+		auto buffer = Buffer::Heap(1000);
+		buffer[999] = 0x42;
+		buffer.selfErase(10, 999);
+
+		REQUIRE(buffer.preallocated() == 989);
+
+		const auto shared = buffer;
+		buffer.selfShrinkToFit();
+
+		REQUIRE(buffer.preallocated() == 989);
+
+		buffer = Buffer();
+		auto owner = shared.clone();
+		owner.selfPreallocate(100).selfShrinkToFit();
+
+		REQUIRE(owner.preallocated() == 0);
+		REQUIRE(owner == shared);
+		REQUIRE(owner.size() == 11);
+		REQUIRE(owner[10] == 0x42);
+
+		REQUIRE(Buffer::HeapPreall(16).selfShrinkToFit().totalsize() == 0);
+		REQUIRE(s_staticbuf.range(0, 4).selfShrinkToFit() == Buffer::Static((void *)"i am", 4));
+	}
+
+	SECTION("commit")
+	{
+		auto buffer = Buffer::HeapFrom((void *)"ab", 2);
+		buffer.selfPreallocate(4);
+
+		std::memcpy(static_cast<std::uint8_t *>(buffer.data()) + 2, "cde", 3);
+		buffer.selfCommit(3);
+
+		REQUIRE(buffer == Buffer::Static((void *)"abcde", 5));
+		REQUIRE(buffer.preallocated() == 1);
+
+		REQUIRE_THROWS(buffer.selfCommit(2));
+
+		const auto shared = buffer;
+		REQUIRE_THROWS(buffer.selfCommit(1));
+		REQUIRE(buffer.size() == 5);
+	}
+
+	SECTION("automatic trim")
+	{
+		const auto previous = Buffer::trimPolicy();
+		Buffer::setTrimPolicy({1.0f, 64});
+
+		auto buffer = Buffer::Heap(200);
+
+		buffer.selfErase(0, 50);
+		REQUIRE(buffer.preallocated() == 50);
+
+		buffer.selfErase(0, 20);
+		REQUIRE(buffer.preallocated() == 70);
+
+		buffer.selfErase(0, 60);
+		REQUIRE(buffer.preallocated() == 0);
+		REQUIRE(buffer.size() == 70);
+
+		Buffer::setTrimPolicy(previous);
+	}
+
+#ifdef CPPX_BUFFER_STATS
+	SECTION("statistics")
+	{
+		const cppx::BufferManager counted = {"counted", {1, 1, 1}, Buffer::heapManager.alloc, Buffer::heapManager.release};
+
+		{
+			auto buffer = Buffer(&counted, 16);
+			auto copy = buffer.clone();
+			auto part = buffer.range(4, 8);
+			auto joined = buffer.insert(0, part);
+
+			REQUIRE(counted.stats().allocations == 4);
+			REQUIRE(counted.stats().bytesLive == 16 + 16 + 4 + 20);
+			REQUIRE(counted.stats().copies == 3);
+			REQUIRE(counted.stats().bytesCopied == 16 + 4 + 20);
+
+			auto shared = buffer;
+			shared[0] = 0x01;
+
+			REQUIRE(counted.stats().detaches == 1);
+
+			buffer.selfPreallocate(8);
+			buffer.selfAppend(part);
+			buffer.selfAppend(part);
+			buffer.selfAppend(part);
+
+			REQUIRE(counted.stats().preallocationHits == 2);
+			REQUIRE(counted.stats().preallocationMisses == 1);
+
+			const cppx::BufferManager resizing = {"resizing", {1, 1, 0}, Buffer::heapManager.alloc, Buffer::heapManager.release, Buffer::heapManager.reallocate};
+			auto grown = Buffer(&resizing, 16);
+			grown.selfAppend(part).selfShrinkToFit();
+
+			REQUIRE(resizing.stats().allocations == 1);
+			REQUIRE(resizing.stats().reallocations == 1);
+			REQUIRE(resizing.stats().bytesLive == 20);
+		}
+
+		const auto stats = counted.stats();
+
+		REQUIRE(stats.releases == stats.allocations);
+		REQUIRE(stats.bytesLive == 0);
+		REQUIRE(stats.bytesPeak >= 16 + 16 + 4 + 20 + 16);
+
+		std::stringstream dump;
+		counted.dumpStats(dump);
+
+		REQUIRE(dump.str() == "counted: " + stats.toString() + "\n");
+
+		counted.resetStats();
+
+		REQUIRE(counted.stats().allocations == 0);
+		REQUIRE(counted.stats().bytesPeak == 0);
 	}
+#endif // defined(CPPX_BUFFER_STATS)
 }
@@ -0,0 +1,162 @@
+#include <catch2/catch_all.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cppxBuffer.hpp"
+#include "cppxCache.hpp"
+
+namespace {
+cppx::Buffer text(const std::string &value)
+{
+	return cppx::Buffer::HeapFrom((void *)value.data(), value.size());
+}
+} // namespace
+
+TEST_CASE("cppx::BufferCache", "[BufferCache]")
+{
+	using cppx::Buffer;
+	using cppx::BufferCache;
+
+	SECTION("values are shared, not copied")
+	{
+		BufferCache cache(1 << 20);
+		const auto value = Buffer::Heap(1000);
+
+		REQUIRE(cache.put(text("key"), value));
+		REQUIRE(value.shared());
+
+		Buffer found;
+		REQUIRE(cache.get(text("key"), found));
+		REQUIRE(found.data() == value.data());
+
+		REQUIRE_FALSE(cache.get(text("other"), found));
+		REQUIRE(found.data() == value.data());
+
+		const auto stats = cache.stats();
+		REQUIRE(stats.hits == 1);
+		REQUIRE(stats.misses == 1);
+		REQUIRE(stats.insertions == 1);
+		REQUIRE(stats.entries == 1);
+		REQUIRE(stats.bytes == 1003);
+		REQUIRE(stats.hitRatio() == 0.5);
+	}
+
+	SECTION("keys are copied")
+	{
+		BufferCache cache(1 << 20);
+		auto key = text("key");
+
+		cache.put(key, text("value"));
+		key[0] = 'K';
+
+		Buffer found;
+		REQUIRE(cache.get(text("key"), found));
+		REQUIRE(found == text("value"));
+		REQUIRE_FALSE(cache.get(key, found));
+	}
+
+	SECTION("least recently used entries are evicted by bytes")
+	{
+		BufferCache cache(3 * 101, 1);
+
+		cache.put(text("a"), Buffer::Heap(100));
+		cache.put(text("b"), Buffer::Heap(100));
+		cache.put(text("c"), Buffer::Heap(100));
+
+		Buffer found;
+		REQUIRE(cache.get(text("a"), found));
+
+		cache.put(text("d"), Buffer::Heap(100));
+
+		REQUIRE(cache.get(text("a"), found));
+		REQUIRE_FALSE(cache.get(text("b"), found));
+		REQUIRE(cache.get(text("c"), found));
+		REQUIRE(cache.get(text("d"), found));
+
+		// a large entry pushes out several small ones
+		cache.put(text("e"), Buffer::Heap(200));
+		REQUIRE(cache.stats().evictions == 3);
+		REQUIRE(cache.stats().bytes <= cache.budget());
+
+		REQUIRE_FALSE(cache.put(text("f"), Buffer::Heap(1000)));
+		REQUIRE(cache.stats().entries == 2);
+	}
+
+	SECTION("the budget is shared by the shards")
+	{
+		BufferCache cache(1000, 16);
+
+		// larger than a sixteenth of the budget, and than the budget split evenly
+		REQUIRE(cache.put(text("large"), Buffer::Heap(900)));
+		REQUIRE(cache.stats().entries == 1);
+
+		for (int i = 0; i < 50; ++i)
+			REQUIRE(cache.put(text(std::to_string(i)), Buffer::Heap(98)));
+
+		const auto stats = cache.stats();
+		REQUIRE(stats.bytes <= cache.budget());
+		REQUIRE(stats.bytes > cache.budget() - 100);
+
+		Buffer found;
+		REQUIRE_FALSE(cache.get(text("large"), found));
+		REQUIRE(cache.get(text("49"), found));
+	}
+
+	SECTION("put replaces and erase removes")
+	{
+		BufferCache cache(1 << 20);
+
+		cache.put(text("key"), text("one"));
+		cache.put(text("key"), text("three"));
+
+		Buffer found;
+		REQUIRE(cache.get(text("key"), found));
+		REQUIRE(found == text("three"));
+		REQUIRE(cache.stats().entries == 1);
+		REQUIRE(cache.stats().bytes == 8);
+
+		REQUIRE(cache.erase(text("key")));
+		REQUIRE_FALSE(cache.erase(text("key")));
+		REQUIRE(cache.stats().bytes == 0);
+
+		cache.put(text("key"), text("value"));
+		cache.clear();
+		REQUIRE(cache.stats().entries == 0);
+
+		cache.resetStats();
+		REQUIRE(cache.stats().hits == 0);
+	}
+
+#ifdef CPPX_BUFFER_ATOMIC
+	SECTION("concurrent access")
+	{
+		BufferCache cache(64 * 1024, 8);
+		std::vector<std::thread> workers;
+
+		for (int t = 0; t < 8; ++t)
+			workers.emplace_back([&cache, t]() {
+				Buffer found;
+
+				for (int i = 0; i < 5000; ++i) {
+					const auto key = text(std::to_string((i * 7 + t) % 300));
+
+					if (!cache.get(key, found))
+						cache.put(key, Buffer::Heap(512));
+				}
+			});
+
+		for (auto &worker : workers)
+			worker.join();
+
+		const auto stats = cache.stats();
+		REQUIRE(stats.hits + stats.misses == 40000);
+		REQUIRE(stats.bytes <= cache.budget());
+	}
+#endif // defined(CPPX_BUFFER_ATOMIC)
+
+	SECTION("constructor checks the shard count")
+	{
+		REQUIRE_THROWS(BufferCache(1024, 0));
+	}
+}
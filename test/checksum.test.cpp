@@ -0,0 +1,109 @@
+#include <catch2/catch_all.hpp>
+#include <vector>
+
+#include "cppxBuffer.hpp"
+#include "cppxChecksum.hpp"
+
+namespace {
+std::uint32_t referenceCrc32c(const std::uint8_t *data, std::size_t size)
+{
+	std::uint32_t crc = ~0u;
+
+	for (std::size_t i = 0; i < size; ++i) {
+		crc ^= data[i];
+
+		for (int bit = 0; bit < 8; ++bit)
+			crc = (crc & 1) ? (crc >> 1) ^ 0x82F63B78u : crc >> 1;
+	}
+
+	return ~crc;
+}
+
+std::uint32_t referenceAdler32(const std::uint8_t *data, std::size_t size)
+{
+	std::uint32_t a = 1, b = 0;
+
+	for (std::size_t i = 0; i < size; ++i) {
+		a = (a + data[i]) % 65521;
+		b = (b + a) % 65521;
+	}
+
+	return a | (b << 16);
+}
+} // namespace
+
+TEST_CASE("cppx checksums", "[Checksum]")
+{
+	using cppx::Buffer;
+
+	const auto check = Buffer::Static((void *)"123456789", 9);
+
+	auto large = Buffer::Heap(100003);
+	for (std::size_t i = 0; i < large.size(); ++i)
+		large[i] = static_cast<std::uint8_t>((i * 2654435761u) >> 13);
+
+	const auto largeData = reinterpret_cast<const std::uint8_t *>(large.data());
+
+	SECTION("known values")
+	{
+		REQUIRE(cppx::crc32c(check) == 0xE3069283u);
+		REQUIRE(cppx::crc32c(Buffer()) == 0);
+
+		REQUIRE(cppx::adler32(Buffer::Static((void *)"Wikipedia", 9)) == 0x11E60398u);
+		REQUIRE(cppx::adler32(Buffer()) == 1);
+	}
+
+	SECTION("large buffers match bytewise reference")
+	{
+		REQUIRE(cppx::crc32c(large) == referenceCrc32c(largeData, large.size()));
+		REQUIRE(cppx::adler32(large) == referenceAdler32(largeData, large.size()));
+	}
+
+	SECTION("the portable path matches on every machine")
+	{
+		REQUIRE(cppx::crc32cPortable("123456789", 9) == 0xE3069283u);
+		REQUIRE(cppx::crc32cPortable(nullptr, 0) == 0);
+
+		// every alignment and tail length of the 8-byte slices
+		for (std::size_t offset = 0; offset < 8; ++offset)
+			for (const std::size_t size : {std::size_t(0), std::size_t(1), std::size_t(7), std::size_t(8), std::size_t(9), std::size_t(4099), large.size() - 8})
+				REQUIRE(cppx::crc32cPortable(largeData + offset, size) == referenceCrc32c(largeData + offset, size));
+
+		REQUIRE(cppx::crc32cPortable(largeData + 1000, large.size() - 1000, cppx::crc32cPortable(largeData, 1000)) == cppx::crc32c(large));
+	}
+
+	SECTION("ranges")
+	{
+		REQUIRE(cppx::crc32c(check, 2, 6) == cppx::crc32c("3456", 4));
+		REQUIRE(cppx::adler32(check, 2, 6) == cppx::adler32("3456", 4));
+
+		REQUIRE_THROWS(cppx::crc32c(check, 6, 2));
+		REQUIRE_THROWS(cppx::adler32(check, 0, 10));
+	}
+
+	SECTION("continuation and chains")
+	{
+		const auto split = GENERATE(std::size_t(0), std::size_t(1), std::size_t(4099), std::size_t(12288), std::size_t(100003));
+
+		const auto left = large.range(0, split, Buffer::onHeap);
+		const auto right = large.range(split, large.size(), Buffer::onHeap);
+
+		REQUIRE(cppx::crc32c(right, cppx::crc32c(left)) == cppx::crc32c(large));
+		REQUIRE(cppx::adler32(right, cppx::adler32(left)) == cppx::adler32(large));
+
+		REQUIRE(cppx::crc32c(std::vector<Buffer>{left, right}) == cppx::crc32c(large));
+		REQUIRE(cppx::adler32(std::vector<Buffer>{left, right}) == cppx::adler32(large));
+	}
+
+	SECTION("combining checksums of appended buffers")
+	{
+		const auto split = GENERATE(std::size_t(0), std::size_t(7), std::size_t(65536), std::size_t(100003));
+
+		const auto left = large.range(0, split, Buffer::onHeap);
+		const auto right = large.range(split, large.size(), Buffer::onHeap);
+		const auto joined = left.append(right, Buffer::onHeap);
+
+		REQUIRE(cppx::crc32cCombine(cppx::crc32c(left), cppx::crc32c(right), right.size()) == cppx::crc32c(joined));
+		REQUIRE(cppx::adler32Combine(cppx::adler32(left), cppx::adler32(right), right.size()) == cppx::adler32(joined));
+	}
+}
@@ -0,0 +1,152 @@
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+#include <vector>
+
+#include "cppxBuffer.hpp"
+#include "cppxColumnStore.hpp"
+
+namespace {
+#pragma pack(push, 1)
+struct Record {
+	std::uint32_t id;
+	double price;
+	std::uint8_t flags;
+};
+#pragma pack(pop)
+
+std::vector<Record> records(std::size_t count, std::uint32_t first = 0)
+{
+	std::vector<Record> result(count);
+
+	for (std::size_t i = 0; i < count; ++i)
+		result[i] = Record{first + static_cast<std::uint32_t>(i), 0.5 * static_cast<double>(first + i), static_cast<std::uint8_t>(i & 0xFF)};
+
+	return result;
+}
+} // namespace
+
+TEST_CASE("cppx::ColumnStore", "[ColumnStore]")
+{
+	using cppx::Buffer;
+	using cppx::ColumnStore;
+
+	ColumnStore store({sizeof(std::uint32_t), sizeof(double), sizeof(std::uint8_t)});
+
+	REQUIRE(store.columns() == 3);
+	REQUIRE(store.rows() == 0);
+	REQUIRE(store.rowSize() == sizeof(Record));
+	REQUIRE(store.width(1) == sizeof(double));
+
+	SECTION("constructor checks the columns")
+	{
+		REQUIRE_THROWS(ColumnStore({}));
+		REQUIRE_THROWS(ColumnStore({4, 0}));
+		REQUIRE_THROWS(ColumnStore({4}, Buffer::onStack));
+	}
+
+	SECTION("row-major records are split into columns")
+	{
+		const auto first = records(1000);
+		const auto second = records(1, 1000);
+
+		store.selfAppendRows(first.data(), first.size());
+		store.selfAppendRows(second.data(), second.size());
+
+		REQUIRE(store.rows() == 1001);
+		REQUIRE(store.capacity() >= 1001);
+
+		const auto ids = store.view<std::uint32_t>(0);
+		REQUIRE(std::accumulate(ids.begin(), ids.end(), std::uint64_t(0)) == 1000 * 1001 / 2);
+
+		const auto prices = store.view<double>(1);
+		REQUIRE(prices[1000] == 500.0);
+
+		REQUIRE(store.column(2).size() == 1001);
+		REQUIRE(store.column(2)[255] == 0xFF);
+
+		for (const std::size_t row : {std::size_t(0), std::size_t(77), std::size_t(1000)}) {
+			const auto record = store.row(row);
+			const auto &expected = row < 1000 ? first[row] : second[0];
+
+			REQUIRE(record.size() == sizeof(Record));
+			REQUIRE(std::memcmp(record.data(), &expected, sizeof(Record)) == 0);
+		}
+
+		REQUIRE_THROWS(store.row(1001));
+		REQUIRE_THROWS(store.view<float>(1));
+		REQUIRE_THROWS(store.column(3));
+	}
+
+	SECTION("columns are appended in batches")
+	{
+		std::uint32_t ids[] = {7, 8};
+		double prices[] = {1.0, 2.0};
+		std::uint8_t flags[] = {1, 2};
+
+		store.selfAppendColumns({Buffer::Stack(ids, sizeof(ids)), Buffer::Stack(prices, sizeof(prices)), Buffer::Stack(flags, sizeof(flags))});
+
+		REQUIRE(store.rows() == 2);
+		REQUIRE(store.view<std::uint32_t>(0)[1] == 8);
+		REQUIRE(store.view<double>(1)[0] == 1.0);
+
+		REQUIRE_THROWS(store.selfAppendColumns({Buffer::Stack(ids, sizeof(ids))}));
+		REQUIRE_THROWS(store.selfAppendColumns({Buffer::Stack(ids, sizeof(ids)), Buffer::Stack(prices, sizeof(double)), Buffer::Stack(flags, sizeof(flags))}));
+		REQUIRE(store.rows() == 2);
+	}
+
+	SECTION("views write through to the store")
+	{
+		const auto rows = records(64);
+		store.selfAppendRows(rows.data(), rows.size());
+
+		for (auto &price : store.view<double>(1))
+			price *= 2;
+
+		const auto &readonly = store;
+		REQUIRE(readonly.view<double>(1)[10] == 10.0);
+		REQUIRE_THROWS(Buffer(readonly.column(1)).at(0) = 0);
+	}
+
+	SECTION("copies write to their own columns")
+	{
+		const auto rows = records(2);
+		store.selfAppendRows(rows.data(), rows.size());
+
+		auto copy = store;
+		const auto more = records(1, 99);
+		const auto other = records(1, 77);
+
+		store.selfAppendRows(more.data(), more.size());
+		copy.selfAppendRows(other.data(), other.size());
+
+		REQUIRE(store.view<std::uint32_t>(0)[2] == 99);
+		REQUIRE(copy.view<std::uint32_t>(0)[2] == 77);
+
+		auto again = store;
+		again.view<std::uint32_t>(0)[0] = 1234;
+
+		REQUIRE(store.view<std::uint32_t>(0)[0] == 0);
+		REQUIRE(again.view<std::uint32_t>(0)[0] == 1234);
+
+		const auto &readonly = store;
+		REQUIRE(readonly.view<std::uint32_t>(0)[1] == 1);
+	}
+
+	SECTION("reserve and clear keep the capacity")
+	{
+		store.selfReserve(5000);
+		const auto capacity = store.capacity();
+		REQUIRE(capacity >= 5000);
+
+		const auto rows = records(5000);
+		store.selfAppendRows(rows.data(), rows.size());
+		REQUIRE(store.capacity() == capacity);
+
+		store.selfClear();
+		REQUIRE(store.rows() == 0);
+		REQUIRE(store.capacity() == capacity);
+		REQUIRE(store.view<std::uint32_t>(0).empty());
+	}
+}
@@ -0,0 +1,126 @@
+#include <catch2/catch_all.hpp>
+#include <string>
+
+#include "cppxBuffer.hpp"
+#include "cppxCompress.hpp"
+
+namespace {
+cppx::Buffer makeText(std::size_t size)
+{
+	static const std::string words[] = {"buffer ", "manager ", "core ", "the ", "preallocated ", "heap ", "stack\n"};
+
+	auto result = cppx::Buffer::Heap(size);
+	std::uint32_t state = 12345;
+
+	for (std::size_t i = 0; i < size;) {
+		state = state * 1103515245u + 12345u;
+		const auto &word = words[(state >> 16) % 7];
+
+		for (std::size_t j = 0; j < word.size() && i < size; ++j, ++i)
+			result[i] = static_cast<std::uint8_t>(word[j]);
+	}
+
+	return result;
+}
+
+cppx::Buffer makeNoise(std::size_t size)
+{
+	auto result = cppx::Buffer::Heap(size);
+	std::uint32_t state = 67890;
+
+	for (std::size_t i = 0; i < size; ++i) {
+		state = state * 1103515245u + 12345u;
+		result[i] = static_cast<std::uint8_t>(state >> 24);
+	}
+
+	return result;
+}
+} // namespace
+
+TEST_CASE("cppx::Compression", "[Compression]")
+{
+	using cppx::Buffer;
+	using cppx::Compression;
+
+	SECTION("round trips")
+	{
+		const auto size = GENERATE(std::size_t(0), std::size_t(1), std::size_t(12), std::size_t(13), std::size_t(1000), std::size_t(65535), std::size_t(200000));
+
+		const auto text = makeText(size);
+		const auto noise = makeNoise(size);
+
+		for (const auto &source : {text, noise}) {
+			const auto compressed = Compression::compress(source);
+
+			REQUIRE(compressed.size() <= Compression::bound(source.size()));
+			REQUIRE(Compression::decompress(compressed) == source);
+		}
+	}
+
+	SECTION("compresses redundant data")
+	{
+		const auto text = makeText(200000);
+		const auto compressed = Compression::compress(text);
+
+		REQUIRE(compressed.size() < text.size() / 2);
+	}
+
+	SECTION("runs of a single byte")
+	{
+		auto run = Buffer::Heap(100000);
+		for (std::size_t i = 0; i < run.size(); ++i)
+			run[i] = 0xAA;
+
+		const auto compressed = Compression::compress(run);
+
+		REQUIRE(compressed.size() < 1000);
+		REQUIRE(Compression::decompress(compressed) == run);
+	}
+
+	SECTION("static sources need a manager")
+	{
+		const auto source = Buffer::Static((void *)"static static static static", 27);
+
+		REQUIRE_THROWS(Compression::compress(source));
+		REQUIRE(Compression::decompress(Compression::compress(source, Buffer::onHeap)) == source);
+	}
+
+	SECTION("rejects corrupted data")
+	{
+		auto compressed = Compression::compress(makeText(5000));
+
+		REQUIRE_THROWS(Compression::decompress(compressed.range(0, compressed.size() - 1, Buffer::onHeap)));
+
+		compressed[4] ^= 0xFF;
+		REQUIRE_THROWS(Compression::decompress(compressed));
+	}
+
+	SECTION("streaming")
+	{
+		const auto text = makeText(300000);
+		const auto chunkSize = GENERATE(std::size_t(1000), std::size_t(65535), std::size_t(100000));
+
+		cppx::CompressStream compressor;
+		auto compressed = Buffer(Buffer::onHeap);
+
+		for (std::size_t offset = 0; offset < text.size(); offset += chunkSize) {
+			const auto end = offset + chunkSize < text.size() ? offset + chunkSize : text.size();
+			compressed.selfAppend(compressor.write(text.range(offset, end)));
+		}
+
+		compressed.selfAppend(compressor.flush());
+
+		REQUIRE(Compression::decompress(compressed) == text);
+
+		cppx::DecompressStream decompressor;
+		auto decompressed = Buffer(Buffer::onHeap);
+
+		for (std::size_t offset = 0; offset < compressed.size(); offset += 777) {
+			const auto end = offset + 777 < compressed.size() ? offset + 777 : compressed.size();
+			decompressed.selfAppend(decompressor.write(compressed.range(offset, end)));
+		}
+
+		REQUIRE_FALSE(decompressor.pending());
+		REQUIRE(decompressed == text);
+	}
+}
@@ -0,0 +1,72 @@
+#include <array>
+#include <catch2/catch_all.hpp>
+#include <string>
+#include <unordered_map>
+
+#include "cppxBuffer.hpp"
+#include "cppxHash.hpp"
+
+TEST_CASE("cppx::Hasher", "[Hash]")
+{
+	using cppx::Buffer;
+	using cppx::Hasher;
+
+	static std::array<std::uint8_t, 100> s_data = {};
+	for (std::size_t i = 0; i < s_data.size(); ++i)
+		s_data[i] = static_cast<std::uint8_t>(i * 7);
+
+	const auto buffer = Buffer::Static((void *)s_data.data(), s_data.size());
+
+	SECTION("known digests")
+	{
+		REQUIRE(Hasher::hash(nullptr, 0) == 0xEF46DB3751D8E999ull);
+		REQUIRE(Hasher::hash("abc", 3) == 0x44BC2CF5AD770999ull);
+		REQUIRE(Hasher::hash(buffer) == 0x8E2272C08247D5DBull);
+		REQUIRE(Hasher::hash(buffer, 0x1234) == 0xE0272767D44D6D5Dull);
+	}
+
+	SECTION("empty buffers hash alike")
+	{
+		REQUIRE(Hasher::hash(Buffer()) == Hasher::hash(Buffer::Heap(0)));
+		REQUIRE(std::hash<Buffer>()(Buffer()) == std::hash<Buffer>()(Buffer::Heap(0)));
+	}
+
+	SECTION("incremental updates match one-shot hashing")
+	{
+		const auto split = GENERATE(0, 1, 3, 31, 32, 33, 64, 99, 100);
+
+		Hasher hasher;
+		hasher.update(buffer.range(0, split, Buffer::onHeap));
+		hasher.update(buffer.range(split, buffer.size(), Buffer::onHeap));
+
+		REQUIRE(hasher.digest() == Hasher::hash(buffer));
+
+		Hasher bytewise;
+		for (const auto byte : s_data)
+			bytewise.update(&byte, 1);
+
+		REQUIRE(bytewise.digest() == Hasher::hash(buffer));
+	}
+
+	SECTION("reset restarts the stream")
+	{
+		Hasher hasher(0x1234);
+		hasher.update(buffer).update(buffer);
+		hasher.reset(0x1234).update(buffer);
+
+		REQUIRE(hasher.digest() == Hasher::hash(buffer, 0x1234));
+	}
+
+	SECTION("std::hash specialization keys unordered containers")
+	{
+		std::unordered_map<Buffer, int> map;
+
+		map[Buffer::HeapFrom((void *)"key1", 4)] = 1;
+		map[Buffer::HeapFrom((void *)"key2", 4)] = 2;
+
+		REQUIRE(map.size() == 2);
+		REQUIRE(map.at(Buffer::Static((void *)"key1", 4)) == 1);
+		REQUIRE(map.at(Buffer::Static((void *)"key2", 4)) == 2);
+		REQUIRE(map.count(Buffer::Static((void *)"key3", 4)) == 0);
+	}
+}
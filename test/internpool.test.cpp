@@ -0,0 +1,119 @@
+#include <catch2/catch_all.hpp>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "cppxBuffer.hpp"
+#include "cppxInternPool.hpp"
+
+namespace {
+cppx::Buffer text(const std::string &value)
+{
+	return cppx::Buffer::HeapFrom((void *)value.data(), value.size());
+}
+} // namespace
+
+TEST_CASE("cppx::InternPool", "[InternPool]")
+{
+	using cppx::Buffer;
+	using cppx::InternPool;
+
+	InternPool pool;
+
+	SECTION("equal contents share one buffer")
+	{
+		const auto first = pool.intern(text("content-type"));
+		const auto second = pool.intern(text("content-type"));
+		const auto other = pool.intern(text("content-length"));
+
+		REQUIRE(first.data() == second.data());
+		REQUIRE(first.data() != other.data());
+		REQUIRE(first == text("content-type"));
+
+		REQUIRE(pool.size() == 2);
+		REQUIRE(pool.bytes() == 26);
+		REQUIRE(pool.contains(text("content-length")));
+		REQUIRE_FALSE(pool.contains(text("accept")));
+
+		REQUIRE(first.manager() == Buffer::onHeapCow);
+	}
+
+	SECTION("empty buffers are not pooled")
+	{
+		REQUIRE(pool.intern(Buffer()).size() == 0);
+		REQUIRE(pool.intern(Buffer::Heap(0)).size() == 0);
+		REQUIRE(pool.size() == 0);
+	}
+
+	SECTION("entries are evicted once nothing else refers to them")
+	{
+		auto kept = pool.intern(text("kept"));
+		pool.intern(text("dropped")).size();
+
+		REQUIRE(pool.sweep() == 1);
+		REQUIRE(pool.size() == 1);
+		REQUIRE(pool.contains(text("kept")));
+
+		kept = Buffer();
+		REQUIRE(pool.sweep() == 1);
+		REQUIRE(pool.size() == 0);
+	}
+
+	SECTION("interning sweeps growing shards")
+	{
+		InternPool single(1);
+
+		for (int i = 0; i < 10000; ++i)
+			single.intern(text(std::to_string(i))).size();
+
+		// none of them is referenced, so the pool never holds more than a sweep's worth
+		REQUIRE(single.size() <= 128);
+	}
+
+	SECTION("modifying a returned buffer leaves the pooled one unchanged")
+	{
+		auto copy = pool.intern(text("abc"));
+		copy[0] = 'x';
+
+		REQUIRE(pool.intern(text("abc")) == text("abc"));
+		REQUIRE(copy == text("xbc"));
+	}
+
+#ifdef CPPX_BUFFER_ATOMIC
+	SECTION("concurrent interning")
+	{
+		constexpr const int threads = 8, keys = 512;
+		std::vector<std::vector<Buffer>> results(threads);
+		std::vector<std::thread> workers;
+
+		for (int t = 0; t < threads; ++t)
+			workers.emplace_back([&pool, &results, t]() {
+				for (int round = 0; round < 4; ++round)
+					for (int k = 0; k < keys; ++k) {
+						auto interned = pool.intern(text("key-" + std::to_string(k)));
+
+						if (round == 0)
+							results[t].push_back(interned);
+					}
+			});
+
+		for (auto &worker : workers)
+			worker.join();
+
+		REQUIRE(pool.size() == keys);
+
+		for (int t = 1; t < threads; ++t)
+			for (int k = 0; k < keys; ++k)
+				REQUIRE(results[t][k].data() == results[0][k].data());
+
+		results.clear();
+		REQUIRE(pool.sweep() == keys);
+	}
+#endif // defined(CPPX_BUFFER_ATOMIC)
+
+	SECTION("constructor checks its arguments")
+	{
+		REQUIRE_THROWS(InternPool(0));
+		REQUIRE_THROWS(InternPool(4, Buffer::onStatic));
+	}
+}
@@ -0,0 +1,136 @@
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <cstring>
+
+#include "cppxBuffer.hpp"
+#include "cppxManagers.hpp"
+
+TEST_CASE("cppx::Managers", "[Managers]")
+{
+	using cppx::Buffer;
+	using cppx::Managers;
+
+	static const cppx::BufferManager boundManager = Managers::nodeManager(0);
+	static const cppx::BufferManager missingNodeManager = Managers::nodeManager(4096);
+
+	const cppx::BufferManager *const managers[] = {Managers::onHugePages, Managers::onInterleaved, &boundManager, &missingNodeManager};
+	const auto manager = managers[GENERATE(0, 1, 2, 3)];
+
+	const auto fill = [](Buffer &buffer, std::size_t from) {
+		for (std::size_t i = from; i < buffer.size(); ++i)
+			buffer[i] = static_cast<std::uint8_t>(i * 13 + (i >> 12));
+	};
+
+	const auto check = [](const Buffer &buffer) {
+		const auto data = reinterpret_cast<const std::uint8_t *>(buffer.data());
+
+		for (std::size_t i = 0; i < buffer.size(); ++i)
+			if (data[i] != static_cast<std::uint8_t>(i * 13 + (i >> 12)))
+				return false;
+
+		return true;
+	};
+
+	REQUIRE(Managers::numaNodes() >= 1);
+
+	SECTION("small and large blocks")
+	{
+		auto small = Buffer(manager, 100);
+		auto large = Buffer(manager, Managers::huge_page_size * 3 + 5);
+
+		fill(small, 0);
+		fill(large, 0);
+
+		REQUIRE(check(small));
+		REQUIRE(check(large));
+		REQUIRE(Buffer(manager, 0).size() == 0);
+	}
+
+	SECTION("growth across the mapping threshold keeps the data")
+	{
+		auto buffer = Buffer(manager, 4096);
+		fill(buffer, 0);
+
+		while (buffer.size() < Managers::huge_page_size * 4) {
+			const auto from = buffer.size();
+
+			buffer.selfAppend(Buffer::Heap(from));
+			fill(buffer, from);
+		}
+
+		REQUIRE(check(buffer));
+
+		buffer.selfErase(100, buffer.size());
+		buffer.selfShrinkToFit();
+
+		REQUIRE(buffer.size() == 100);
+		REQUIRE(check(buffer));
+	}
+
+	SECTION("clones onto other managers")
+	{
+		auto large = Buffer(manager, Managers::huge_page_size + 1);
+		fill(large, 0);
+
+		REQUIRE(large.clone(Buffer::onHeap) == large);
+		REQUIRE(large.clone(Buffer::onHeap).clone(manager) == large);
+	}
+}
+
+TEST_CASE("cppx::Managers aligned", "[Managers]")
+{
+	using cppx::Buffer;
+	using cppx::Managers;
+
+	const auto alignment = GENERATE(std::size_t(16), std::size_t(32), std::size_t(64), std::size_t(4096));
+	const auto manager = Managers::aligned(alignment);
+
+	const auto isAligned = [alignment](const Buffer &buffer) {
+		return reinterpret_cast<std::uintptr_t>(buffer.data()) % alignment == 0;
+	};
+
+	auto buffer = Buffer(manager, 3);
+	buffer[0] = 0x11;
+	buffer[2] = 0x33;
+
+	REQUIRE(isAligned(buffer));
+
+	buffer.selfAppend(Buffer::Heap(5000));
+	REQUIRE(isAligned(buffer));
+
+	buffer.selfPreallocate(100);
+	REQUIRE(isAligned(buffer));
+
+	buffer.selfInsert(3, Buffer::Heap(20000));
+	REQUIRE(isAligned(buffer));
+
+	buffer.selfErase(3, buffer.size()).selfShrinkToFit();
+	REQUIRE(isAligned(buffer));
+	REQUIRE(buffer.size() == 3);
+	REQUIRE(buffer[0] == 0x11);
+	REQUIRE(buffer[2] == 0x33);
+
+	REQUIRE(isAligned(buffer.clone()));
+	REQUIRE(isAligned(Buffer::Heap(77).clone(manager)));
+
+	REQUIRE_THROWS(Managers::aligned(8));
+	REQUIRE_THROWS(Managers::aligned(128));
+}
+
+TEST_CASE("cppx::Managers direct", "[Managers]")
+{
+	using cppx::Buffer;
+	using cppx::Managers;
+
+	auto buffer = Buffer(Managers::onDirect, 100);
+
+	REQUIRE(reinterpret_cast<std::uintptr_t>(buffer.data()) % Managers::page_size == 0);
+
+	// the whole rounded-up page may be written, like a direct read would
+	std::memset(buffer.data(), 0x5A, Managers::page_size);
+
+	buffer.selfAppend(Buffer::Heap(Managers::page_size * 2));
+
+	REQUIRE(reinterpret_cast<std::uintptr_t>(buffer.data()) % Managers::page_size == 0);
+	REQUIRE(buffer[99] == 0x5A);
+}
@@ -0,0 +1,107 @@
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "cppxBuffer.hpp"
+#include "cppxParallel.hpp"
+
+TEST_CASE("cppx::Parallel", "[Parallel]")
+{
+	using cppx::Buffer;
+	using cppx::Parallel;
+
+	const auto policy = Parallel{GENERATE(std::size_t(1), std::size_t(4)), GENERATE(std::size_t(7), std::size_t(4096))};
+
+	auto data = Buffer::Heap(10007);
+	for (std::size_t i = 0; i < data.size(); ++i)
+		data[i] = static_cast<std::uint8_t>(i * 31 + (i >> 8));
+
+	SECTION("chunks cover the input exactly once")
+	{
+		std::vector<std::atomic<int>> visits(1000);
+
+		policy.forEachChunk(visits.size(), [&visits](std::size_t begin, std::size_t end) {
+			for (std::size_t i = begin; i < end; ++i)
+				++visits[i];
+		});
+
+		for (const auto &visit : visits)
+			REQUIRE(visit == 1);
+	}
+
+	SECTION("an exception on the calling thread is passed on once the others stop")
+	{
+		const auto caller = std::this_thread::get_id();
+		std::atomic<bool> thrown(false);
+		std::atomic<std::size_t> pieces(0);
+
+		const auto task = [&](std::size_t, std::size_t) {
+			if (std::this_thread::get_id() == caller) {
+				thrown = true;
+				throw std::runtime_error("piece failed");
+			}
+
+			// the other threads hold their first piece until the caller has one, so it always does
+			while (!thrown)
+				std::this_thread::yield();
+
+			++pieces;
+		};
+
+		REQUIRE_THROWS_AS(policy.forEachChunk(data.size(), task), std::runtime_error);
+		REQUIRE(pieces < (data.size() + policy.chunk - 1) / policy.chunk);
+	}
+
+	SECTION("clone")
+	{
+		const auto cloned = data.clone(policy);
+
+		REQUIRE(cloned == data);
+		REQUIRE(cloned.data() != data.data());
+		REQUIRE(Buffer().clone(policy) == Buffer());
+		REQUIRE_THROWS(Buffer::Static((void *)"abc", 3).clone(policy));
+	}
+
+	SECTION("reverse")
+	{
+		REQUIRE(data.reverse(policy) == data.reverse());
+		REQUIRE_THROWS(Buffer::Static((void *)"abc", 3).reverse(policy));
+	}
+
+	SECTION("compare")
+	{
+		auto other = data.clone();
+		REQUIRE(data.compare(other, policy) == 0);
+
+		other[9000] = static_cast<std::uint8_t>(other[9000] + 1);
+		other[5000] = static_cast<std::uint8_t>(other[5000] - 1);
+
+		REQUIRE(data.compare(other, policy) == data.compare(other));
+		REQUIRE(other.compare(data, policy) == other.compare(data));
+		REQUIRE(data.compare(data.range(0, 10), policy) == 1);
+	}
+
+	SECTION("insert")
+	{
+		const auto value = data.range(100, 3000, Buffer::onHeap);
+		const auto index = GENERATE(std::size_t(0), std::size_t(5), std::size_t(10007));
+
+		REQUIRE(data.insert(index, value, policy) == data.insert(index, value));
+		REQUIRE(Buffer().insert(0, value, policy, Buffer::onHeap) == value);
+		REQUIRE_THROWS(data.insert(data.size() + 1, value, policy));
+	}
+
+	SECTION("represent")
+	{
+		const auto form = GENERATE(
+		    std::uint8_t(Buffer::HEX),
+		    std::uint8_t(Buffer::HEX | Buffer::LOWERCASE | Buffer::PREFIXED),
+		    std::uint8_t(Buffer::BINARY | Buffer::PREFIXED),
+		    std::uint8_t(0));
+
+		REQUIRE(data.represent(form, policy) == data.represent(form));
+		REQUIRE(Buffer().represent(form, policy) == "null");
+	}
+}
@@ -0,0 +1,173 @@
+#include <catch2/catch_all.hpp>
+#include <cstring>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "cppxBuffer.hpp"
+#include "cppxPool.hpp"
+
+TEST_CASE("cppx::BufferPool", "[Pool]")
+{
+	using cppx::Buffer;
+	using cppx::BufferPool;
+	using cppx::PoolOptions;
+
+	SECTION("acquired buffers are empty and preallocated")
+	{
+		BufferPool pool(1000);
+		auto buffer = pool.acquire();
+
+		REQUIRE(buffer.size() == 0);
+		REQUIRE(buffer.preallocated() == 1000);
+		REQUIRE(buffer.manager() == pool.manager());
+
+		const auto before = buffer.data();
+		buffer.selfAppend(Buffer::HeapFrom((void *)"abc", 3));
+
+		REQUIRE(buffer.data() == before);
+		REQUIRE(buffer.preallocated() == 997);
+		REQUIRE(std::memcmp(buffer.data(), "abc", 3) == 0);
+	}
+
+	SECTION("released blocks are acquired again")
+	{
+		BufferPool pool(4096);
+		const void *first;
+
+		{
+			auto buffer = pool.acquire();
+			first = buffer.data();
+		}
+
+		REQUIRE(pool.acquire().data() == first);
+
+		for (int i = 0; i < 1000; ++i) {
+			auto buffer = pool.acquire();
+			buffer.selfAppend(Buffer::Heap(100));
+		}
+
+		REQUIRE(pool.allocations() == 1);
+	}
+
+	SECTION("blocks of other sizes bypass the pool")
+	{
+		BufferPool pool(100);
+
+		{
+			auto buffer = pool.acquire();
+			buffer.selfAppend(Buffer::Heap(300));
+
+			REQUIRE(buffer.size() == 300);
+			REQUIRE(buffer.manager() == pool.manager());
+
+			auto copy = buffer.clone();
+			REQUIRE(copy == buffer);
+		}
+
+		REQUIRE(pool.allocations() == 1);
+		REQUIRE(pool.acquire().preallocated() == 100);
+		REQUIRE(pool.allocations() == 1);
+	}
+
+	SECTION("full caches spill to the overflow list, which is capped")
+	{
+		PoolOptions options;
+		options.threadCache = 8;
+		options.overflow = 6;
+
+		BufferPool pool(64, options);
+
+		{
+			std::vector<Buffer> held;
+
+			for (int i = 0; i < 40; ++i)
+				held.push_back(pool.acquire());
+		}
+
+		REQUIRE(pool.allocations() == 40);
+		REQUIRE(pool.overflowSize() == 6);
+
+		REQUIRE(pool.trim() > 6);
+		REQUIRE(pool.overflowSize() == 0);
+
+		REQUIRE(pool.acquire().preallocated() == 64);
+		REQUIRE(pool.allocations() == 41);
+	}
+
+	SECTION("blocks of exiting threads are handed back")
+	{
+		BufferPool pool(256);
+
+		std::thread([&pool]() {
+			std::vector<Buffer> held;
+
+			for (int i = 0; i < 10; ++i)
+				held.push_back(pool.acquire());
+		}).join();
+
+		REQUIRE(pool.overflowSize() == 10);
+
+		for (int i = 0; i < 10; ++i)
+			REQUIRE(pool.acquire().preallocated() == 256);
+
+		REQUIRE(pool.allocations() == 10);
+	}
+
+	SECTION("buffers are recycled across threads")
+	{
+		PoolOptions options;
+		options.threadCache = 16;
+
+		BufferPool pool(512, options);
+		std::vector<std::thread> threads;
+		std::vector<int> mismatches(4, 0);
+
+		for (int t = 0; t < 4; ++t)
+			threads.emplace_back([&pool, &mismatches, t]() {
+				std::vector<Buffer> held;
+
+				for (int i = 0; i < 20000; ++i) {
+					auto buffer = pool.acquire();
+					buffer.selfAppend(Buffer::HeapFrom((void *)&t, sizeof(t)));
+					held.push_back(buffer);
+
+					if (held.size() == 32) {
+						for (const auto &item : held)
+							mismatches[t] += std::memcmp(item.data(), &t, sizeof(t)) != 0;
+
+						held.clear();
+					}
+				}
+			});
+
+		for (auto &thread : threads)
+			thread.join();
+
+		REQUIRE(mismatches == std::vector<int>(4, 0));
+		REQUIRE(pool.allocations() < 4 * 64);
+	}
+
+	SECTION("pools that die before their threads")
+	{
+		auto pool = std::make_unique<BufferPool>(128);
+		REQUIRE(pool->acquire().preallocated() == 128);
+
+		std::thread worker([&pool]() { const auto buffer = pool->acquire(); });
+		worker.join();
+
+		pool.reset();
+		BufferPool other(128);
+		REQUIRE(other.acquire().preallocated() == 128);
+	}
+
+	SECTION("options are checked")
+	{
+		PoolOptions options;
+		options.threadCache = 0;
+
+		REQUIRE_THROWS(BufferPool(0));
+		REQUIRE_THROWS(BufferPool(cppx::BufferCore::max_preall + 1));
+		REQUIRE_THROWS(BufferPool(64, options));
+	}
+}
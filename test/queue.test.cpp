@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#ifndef CPPX_BUFFER_DEBUG
+#define CPPX_BUFFER_DEBUG
+#endif // !defined(CPPX_BUFFER_DEBUG)
+
+#include "cppxBuffer.hpp"
+#include "cppxQueue.hpp"
+
+namespace {
+cppx::Buffer numbered(std::uint32_t number)
+{
+	auto result = cppx::Buffer::Heap(sizeof(number));
+	std::memcpy(result.data(), &number, sizeof(number));
+
+	return result;
+}
+
+std::uint32_t numberOf(const cppx::Buffer &buffer)
+{
+	std::uint32_t result;
+	std::memcpy(&result, buffer.data(), sizeof(result));
+
+	return result;
+}
+
+//! @brief Pushes |count| numbered buffers from each producer and checks that every one arrives exactly once
+template <typename Queue>
+void exchange(Queue &queue, std::uint32_t producers, std::uint32_t consumers, std::uint32_t count)
+{
+	std::vector<std::vector<std::uint32_t>> received(consumers);
+	std::vector<std::thread> threads;
+
+	for (std::uint32_t p = 0; p < producers; ++p)
+		threads.emplace_back([&queue, p, count]() {
+			for (std::uint32_t i = 0; i < count; ++i)
+				queue.push(numbered(p * count + i));
+		});
+
+	const auto share = producers * count / consumers;
+
+	for (std::uint32_t c = 0; c < consumers; ++c)
+		threads.emplace_back([&queue, &received, c, share]() {
+			for (std::uint32_t i = 0; i < share; ++i)
+				received[c].push_back(numberOf(queue.pop()));
+		});
+
+	for (auto &thread : threads)
+		thread.join();
+
+	std::vector<std::uint8_t> seen(producers * count, 0);
+
+	for (const auto &numbers : received) {
+		// each producer's buffers arrive in the order it pushed them
+		std::vector<std::int64_t> last(producers, -1);
+
+		for (const auto number : numbers) {
+			REQUIRE(seen[number]++ == 0);
+			REQUIRE(static_cast<std::int64_t>(number % count) > last[number / count]);
+			last[number / count] = number % count;
+		}
+	}
+
+	REQUIRE(std::count(seen.begin(), seen.end(), 1) == static_cast<std::ptrdiff_t>(producers * count));
+}
+} // namespace
+
+TEST_CASE("cppx::BufferQueue", "[Queue]")
+{
+	using cppx::Buffer;
+	using cppx::BufferQueue;
+
+	SECTION("capacity is a power of two")
+	{
+		REQUIRE(BufferQueue(1).capacity() == 2);
+		REQUIRE(BufferQueue(5).capacity() == 8);
+		REQUIRE(BufferQueue(64).capacity() == 64);
+		REQUIRE_THROWS(BufferQueue(0));
+	}
+
+	SECTION("buffers come out in order, and a full queue refuses more")
+	{
+		BufferQueue queue(4);
+
+		for (std::uint32_t i = 0; i < 4; ++i)
+			REQUIRE(queue.tryPush(numbered(i)));
+
+		auto extra = numbered(4);
+		REQUIRE(!queue.tryPush(std::move(extra)));
+		REQUIRE(numberOf(extra) == 4);
+		REQUIRE(queue.size() == 4);
+
+		Buffer value;
+		for (std::uint32_t i = 0; i < 4; ++i) {
+			REQUIRE(queue.tryPop(value));
+			REQUIRE(numberOf(value) == i);
+		}
+
+		REQUIRE(!queue.tryPop(value));
+		REQUIRE(queue.size() == 0);
+	}
+
+	SECTION("hand-offs move the data without copying or sharing it")
+	{
+		BufferQueue queue(2);
+		auto buffer = Buffer::Heap(1000);
+		const auto data = buffer.data();
+
+		REQUIRE(queue.tryPush(std::move(buffer)));
+		REQUIRE(!buffer);
+
+		const auto popped = queue.pop();
+		REQUIRE(popped.data() == data);
+		REQUIRE(popped.refcount() == 1);
+	}
+
+	SECTION("queued buffers are released with the queue")
+	{
+		const auto kept = Buffer::Heap(10);
+
+		{
+			BufferQueue queue(4);
+			queue.push(Buffer(kept));
+			REQUIRE(kept.refcount() == 2);
+		}
+
+		REQUIRE(kept.refcount() == 1);
+	}
+
+	SECTION("many producers and consumers")
+	{
+		BufferQueue queue(16);
+		exchange(queue, 4, 4, 5000);
+	}
+}
+
+TEST_CASE("cppx::SpscBufferQueue", "[Queue]")
+{
+	using cppx::Buffer;
+	using cppx::SpscBufferQueue;
+
+	SECTION("buffers come out in order, and a full queue refuses more")
+	{
+		SpscBufferQueue queue(3);
+		REQUIRE(queue.capacity() == 4);
+
+		for (std::uint32_t i = 0; i < 4; ++i)
+			REQUIRE(queue.tryPush(numbered(i)));
+
+		auto extra = numbered(4);
+		REQUIRE(!queue.tryPush(std::move(extra)));
+		REQUIRE(numberOf(extra) == 4);
+
+		Buffer value;
+		for (std::uint32_t i = 0; i < 4; ++i) {
+			REQUIRE(queue.tryPop(value));
+			REQUIRE(numberOf(value) == i);
+		}
+
+		REQUIRE(!queue.tryPop(value));
+		REQUIRE_THROWS(SpscBufferQueue(0));
+	}
+
+	SECTION("hand-offs move the data without copying or sharing it")
+	{
+		SpscBufferQueue queue(2);
+		auto buffer = Buffer::Heap(1000);
+		const auto data = buffer.data();
+
+		queue.push(std::move(buffer));
+
+		const auto popped = queue.pop();
+		REQUIRE(popped.data() == data);
+		REQUIRE(popped.refcount() == 1);
+	}
+
+	SECTION("one producer and one consumer")
+	{
+		SpscBufferQueue queue(16);
+		exchange(queue, 1, 1, 50000);
+	}
+}
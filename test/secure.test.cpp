@@ -0,0 +1,123 @@
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <cstring>
+
+#include "cppxBuffer.hpp"
+#include "cppxSecure.hpp"
+
+namespace {
+bool isZero(const void *data, std::size_t size)
+{
+	const auto bytes = static_cast<const std::uint8_t *>(data);
+
+	for (std::size_t i = 0; i < size; ++i)
+		if (bytes[i])
+			return false;
+
+	return true;
+}
+} // namespace
+
+TEST_CASE("cppx::Secure", "[Secure]")
+{
+	using cppx::Buffer;
+	using cppx::Secure;
+
+	SECTION("buffers hold their data")
+	{
+		const auto size = GENERATE(std::size_t(0), std::size_t(1), std::size_t(32), std::size_t(4096), std::size_t(10000));
+
+		auto buffer = Buffer(Secure::onSecure, size);
+		std::memset(buffer.data(), 0xA5, size);
+
+		REQUIRE(buffer.size() == size);
+		REQUIRE(buffer == Buffer::Heap(size).selfClone(buffer, Buffer::onHeap));
+	}
+
+	SECTION("released slots are zeroed and reused")
+	{
+		const void *address = nullptr;
+
+		{
+			auto key = Buffer(Secure::onSecure, 24);
+			std::memset(key.data(), 0xFF, key.size());
+			address = key.data();
+		}
+
+		// pool memory stays mapped, so the old slot can still be inspected
+		REQUIRE(isZero(address, 32));
+
+		auto next = Buffer(Secure::onSecure, 30);
+		REQUIRE(next.data() == address);
+		REQUIRE(isZero(next.data(), next.size()));
+	}
+
+	SECTION("growth zeroes the old block")
+	{
+		auto token = Buffer(Secure::onSecure, 16);
+		std::memset(token.data(), 0x77, token.size());
+
+		const auto old = token.data();
+		token.selfAppend(Buffer::Static((void *)"more", 4));
+
+		REQUIRE(token.data() != old);
+		REQUIRE(isZero(old, 16));
+		REQUIRE(token[15] == 0x77);
+		REQUIRE(token[16] == 'm');
+
+		const auto preallocatedOld = token.data();
+		token.selfPreallocate(100);
+
+		REQUIRE(isZero(preallocatedOld, 20));
+		REQUIRE(token.manager() == Secure::onSecure);
+	}
+
+	SECTION("wipe")
+	{
+		auto buffer = Buffer::Heap(64);
+		std::memset(buffer.data(), 0x42, buffer.size());
+
+		Secure::wipe(buffer);
+		REQUIRE(isZero(buffer.data(), buffer.size()));
+
+		Secure::wipe(nullptr, 10);
+		Buffer empty;
+		Secure::wipe(empty);
+
+		// shared data is zeroed for every holder, read-only data is left alone
+		auto shared = Buffer::Heap(16);
+		std::memset(shared.data(), 0x42, shared.size());
+		auto holder = shared;
+
+		Secure::wipe(holder);
+		REQUIRE(isZero(shared.data(), shared.size()));
+
+		auto literal = Buffer::Static((void *)"literal", 7);
+		Secure::wipe(literal);
+		REQUIRE(literal == Buffer::Static((void *)"literal", 7));
+	}
+
+	SECTION("equal")
+	{
+		const auto size = GENERATE(std::size_t(1), std::size_t(16), std::size_t(31), std::size_t(32), std::size_t(33), std::size_t(1000));
+
+		auto left = Buffer::Heap(size);
+		for (std::size_t i = 0; i < size; ++i)
+			left[i] = static_cast<std::uint8_t>(i * 7);
+
+		auto right = left.clone();
+		REQUIRE(Secure::equal(left, right));
+
+		for (const auto index : {std::size_t(0), size / 2, size - 1}) {
+			for (const std::uint8_t bit : {0x01, 0x80}) {
+				right[index] ^= bit;
+				REQUIRE_FALSE(Secure::equal(left, right));
+				right[index] ^= bit;
+			}
+		}
+
+		REQUIRE(Secure::equal(left, right));
+		REQUIRE_FALSE(Secure::equal(left, left.range(0, size - 1, Buffer::onHeap)));
+		REQUIRE(Secure::equal(Buffer(), Buffer::Heap(0)));
+	}
+}
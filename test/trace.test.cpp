@@ -0,0 +1,175 @@
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_all.hpp>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "cppxBuffer.hpp"
+#include "cppxTrace.hpp"
+
+TEST_CASE("cppx::BufferTrace", "[Trace]")
+{
+	using cppx::Buffer;
+	using cppx::BufferTrace;
+	using cppx::TraceEvent;
+
+	BufferTrace::clear();
+
+	SECTION("ring keeps recorded events in order")
+	{
+		BufferTrace::record(TraceEvent::CREATE, 4, Buffer::onHeap);
+		BufferTrace::record(TraceEvent::RELEASE, 8, Buffer::onHeap);
+
+		const auto events = BufferTrace::events();
+
+		REQUIRE(events.size() == 2);
+		REQUIRE(events[0].type == TraceEvent::CREATE);
+		REQUIRE(events[0].size == 4);
+		REQUIRE(events[0].manager == Buffer::onHeap);
+		REQUIRE(events[0].tag == nullptr);
+		REQUIRE(events[1].type == TraceEvent::RELEASE);
+		REQUIRE(events[1].timestamp >= events[0].timestamp);
+	}
+
+	SECTION("ring overwrites the oldest events")
+	{
+		for (std::size_t i = 0; i < BufferTrace::ring_size + 10; ++i)
+			BufferTrace::record(TraceEvent::ALLOCATE, i, Buffer::onHeap);
+
+		const auto events = BufferTrace::events();
+
+		REQUIRE(events.size() == BufferTrace::ring_size);
+		REQUIRE(events.front().size == 10);
+		REQUIRE(events.back().size == BufferTrace::ring_size + 9);
+	}
+
+	SECTION("concurrent writers and readers never see torn events")
+	{
+		const cppx::BufferManager *const managers[] = {Buffer::onHeap, Buffer::onHeapCow, Buffer::onArena, Buffer::onStack};
+		std::atomic<bool> writing(true);
+		std::vector<std::thread> writers;
+
+		// the size names the writer, whose manager must come with it
+		for (std::uint64_t w = 0; w < 4; ++w)
+			writers.emplace_back([&managers, w]() {
+				for (std::uint64_t i = 0; i < 3 * BufferTrace::ring_size / 4; ++i)
+					BufferTrace::record(TraceEvent::GROW, (w << 32) | i, managers[w]);
+			});
+
+		std::size_t torn = 0;
+		std::thread reader([&]() {
+			while (writing)
+				for (const auto &event : BufferTrace::events())
+					torn += event.size >> 32 >= 4 || event.manager != managers[event.size >> 32];
+		});
+
+		for (auto &writer : writers)
+			writer.join();
+
+		writing = false;
+		reader.join();
+
+		REQUIRE(torn == 0);
+		REQUIRE(BufferTrace::events().size() <= BufferTrace::ring_size);
+	}
+
+	SECTION("scopes tag events")
+	{
+		{
+			BufferTrace::Scope outer("outer");
+			BufferTrace::record(TraceEvent::CREATE, 0, Buffer::onHeap);
+
+			{
+				BufferTrace::Scope inner("inner");
+				BufferTrace::record(TraceEvent::CREATE, 0, Buffer::onHeap);
+			}
+
+			BufferTrace::record(TraceEvent::CREATE, 0, Buffer::onHeap);
+		}
+
+		BufferTrace::record(TraceEvent::CREATE, 0, Buffer::onHeap);
+
+		const auto events = BufferTrace::events();
+
+		REQUIRE(events.size() == 4);
+		REQUIRE(std::string(events[0].tag) == "outer");
+		REQUIRE(std::string(events[1].tag) == "inner");
+		REQUIRE(std::string(events[2].tag) == "outer");
+		REQUIRE(events[3].tag == nullptr);
+	}
+
+	SECTION("callback and disabling")
+	{
+		std::vector<TraceEvent::Type> seen;
+		BufferTrace::setCallback([&seen](const TraceEvent &event) { seen.push_back(event.type); });
+
+		BufferTrace::record(TraceEvent::GROW, 1, Buffer::onHeap);
+
+		BufferTrace::setEnabled(false);
+		BufferTrace::record(TraceEvent::GROW, 2, Buffer::onHeap);
+		BufferTrace::setEnabled(true);
+
+		BufferTrace::setCallback(nullptr);
+		BufferTrace::record(TraceEvent::DETACH, 3, Buffer::onHeap);
+
+		REQUIRE(seen == std::vector<TraceEvent::Type>{TraceEvent::GROW});
+		REQUIRE(BufferTrace::events().size() == 2);
+	}
+
+	SECTION("chrome export")
+	{
+		{
+			BufferTrace::Scope scope("say \"hi\"");
+			BufferTrace::record(TraceEvent::CREATE, 16, Buffer::onHeap);
+		}
+
+		std::stringstream stream;
+		BufferTrace::exportChrome(stream);
+
+		const auto json = stream.str();
+
+		REQUIRE(json.rfind("{\"displayTimeUnit\":\"ns\",\"traceEvents\":[", 0) == 0);
+		REQUIRE(json.find("\"name\":\"create\"") != std::string::npos);
+		REQUIRE(json.find("\"size\":16,\"manager\":\"heapManager\",\"tag\":\"say \\\"hi\\\"\"}") != std::string::npos);
+		REQUIRE(json.find("]}") != std::string::npos);
+
+		std::stringstream empty;
+		BufferTrace::exportChrome(empty, {});
+
+		REQUIRE(empty.str() == "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n]}\n");
+	}
+
+#ifdef CPPX_BUFFER_TRACE
+	SECTION("buffers emit lifetime events")
+	{
+		{
+			BufferTrace::Scope scope("lifetime");
+
+			auto buffer = Buffer::Heap(8);
+			auto copy = Buffer(Buffer::onHeapCow).selfClone(buffer);
+			auto shared = copy;
+
+			shared[0] = 0x01;
+			buffer.selfPreallocate(4);
+			buffer.selfAppend(Buffer::Heap(16));
+		}
+
+		std::vector<TraceEvent::Type> types;
+		for (const auto &event : BufferTrace::events()) {
+			REQUIRE(std::string(event.tag) == "lifetime");
+			types.push_back(event.type);
+		}
+
+		const auto count = [&types](TraceEvent::Type type) {
+			return std::count(types.begin(), types.end(), type);
+		};
+
+		REQUIRE(count(TraceEvent::DETACH) == 1);
+		REQUIRE(count(TraceEvent::GROW) == 2);
+		REQUIRE(count(TraceEvent::CREATE) == count(TraceEvent::RELEASE));
+		REQUIRE(types.front() == TraceEvent::CREATE);
+		REQUIRE(types.back() == TraceEvent::RELEASE);
+	}
+#endif // defined(CPPX_BUFFER_TRACE)
+}
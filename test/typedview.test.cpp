@@ -0,0 +1,129 @@
+#include <catch2/catch_all.hpp>
+#include <cstdint>
+#include <cstring>
+#include <numeric>
+
+#include "cppxBuffer.hpp"
+#include "cppxTypedView.hpp"
+
+namespace {
+#pragma pack(push, 1)
+struct Packed {
+	std::uint8_t tag;
+	std::uint32_t value;
+};
+#pragma pack(pop)
+} // namespace
+
+TEST_CASE("cppx::TypedView", "[TypedView]")
+{
+	using cppx::Buffer;
+	using cppx::TypedView;
+
+	SECTION("elements map onto the bytes")
+	{
+		auto buffer = Buffer::HeapZeroed(4 * sizeof(std::uint32_t));
+		TypedView<std::uint32_t> view(buffer);
+
+		REQUIRE(view.size() == 4);
+		REQUIRE(view.data() == buffer.data());
+
+		std::iota(view.begin(), view.end(), 1u);
+
+		REQUIRE(std::accumulate(view.begin(), view.end(), 0u) == 10u);
+		REQUIRE(view[3] == 4u);
+		REQUIRE(std::memcmp(buffer.data(), view.data(), buffer.size()) == 0);
+
+		REQUIRE_THROWS(view.at(4));
+	}
+
+	SECTION("const views of read-only buffers")
+	{
+		static const float values[] = {0.5f, 1.5f, 2.0f};
+		const auto buffer = Buffer::Static((void *)values, sizeof(values));
+
+		TypedView<const float> view(buffer);
+		REQUIRE(std::accumulate(view.begin(), view.end(), 0.0f) == 4.0f);
+
+		Buffer readonly = buffer;
+		REQUIRE_THROWS(TypedView<float>(readonly));
+	}
+
+	SECTION("size and alignment are checked")
+	{
+		auto odd = Buffer::Heap(7);
+		REQUIRE_THROWS(TypedView<std::uint32_t>(odd));
+		REQUIRE_FALSE(TypedView<std::uint32_t>::fits(odd));
+
+		auto storage = Buffer::Heap(16);
+		auto misaligned = Buffer::Stack(static_cast<std::uint8_t *>(storage.data()) + 1, 8);
+		REQUIRE_THROWS(TypedView<std::uint32_t>(misaligned));
+		REQUIRE_FALSE(TypedView<std::uint32_t>::fits(misaligned));
+
+		Buffer empty;
+		REQUIRE(TypedView<std::uint64_t>(empty).empty());
+	}
+
+	SECTION("shared buffers are detached first")
+	{
+		auto original = Buffer(Buffer::onHeapCow).selfClone(Buffer::HeapZeroed(8));
+		auto copy = original;
+
+		TypedView<std::uint64_t> view(copy);
+		view[0] = 42;
+
+		REQUIRE(TypedView<const std::uint64_t>(original)[0] == 0);
+		REQUIRE(TypedView<const std::uint64_t>(copy)[0] == 42);
+	}
+}
+
+TEST_CASE("cppx::UnalignedView", "[TypedView]")
+{
+	using cppx::Buffer;
+	using cppx::UnalignedView;
+
+	SECTION("misaligned data")
+	{
+		auto storage = Buffer::HeapZeroed(1 + 3 * sizeof(std::uint32_t));
+		auto window = Buffer::Stack(static_cast<std::uint8_t *>(storage.data()) + 1, 3 * sizeof(std::uint32_t));
+
+		UnalignedView<std::uint32_t> view(window);
+
+		REQUIRE(view.size() == 3);
+
+		view[0] = 0x01020304u;
+		view.store(1, 0xA0B0C0D0u);
+		view[2] = view[0];
+
+		REQUIRE(view.load(1) == 0xA0B0C0D0u);
+		REQUIRE(static_cast<std::uint32_t>(view[2]) == 0x01020304u);
+
+		std::uint32_t expected;
+		std::memcpy(&expected, static_cast<std::uint8_t *>(storage.data()) + 1, sizeof(expected));
+		REQUIRE(expected == 0x01020304u);
+
+		REQUIRE_THROWS(view.at(3));
+	}
+
+	SECTION("packed records")
+	{
+		auto buffer = Buffer::HeapZeroed(4 * sizeof(Packed));
+		UnalignedView<Packed> records(buffer);
+
+		for (std::size_t i = 0; i < records.size(); ++i)
+			records[i] = Packed{static_cast<std::uint8_t>(i), static_cast<std::uint32_t>(i * 1000)};
+
+		std::uint32_t sum = 0;
+		for (const Packed record : UnalignedView<const Packed>(static_cast<const Buffer &>(buffer)))
+			sum += record.value;
+
+		REQUIRE(sum == 6000);
+		REQUIRE(records.end() - records.begin() == 4);
+	}
+
+	SECTION("size is checked")
+	{
+		auto odd = Buffer::Heap(7);
+		REQUIRE_THROWS(UnalignedView<std::uint32_t>(odd));
+	}
+}